@@ -0,0 +1,440 @@
+/**
+ * @file bench.cpp
+ * @author Dragoslav Rakić (dragoslav_rakic@outlook.com)
+ * @date 15, February, 2017
+ * @brief Benchmark of the stages of the tunnel solver on deterministic synthetic groups.
+ *
+ * For every group size from --min-n to --max-n and for every distribution of speeds (uniform, skewed and duplicate)
+ * benchmark creates one group with fixed seed and measures every stage separately:
+ * - generate  - creation of all solution matrices with operator()
+ * - scan      - forward->backward and backward->forward scans with operators >> and <<
+ * - enumerate - sorting of paths from pathEnumerator into vector, at most --path-limit paths
+ * - minimum   - selection of the quickest path from sorted paths, as printMinimum does
+ * - count     - countPaths, numbers of all paths and of the quickest paths without enumeration, items are edges
+ * - bound     - boundPath, branch and bound search over edges of the generators
+ * - resolve   - incrementalSolver after speed change of the slowest person, items are computed rows
+ * - dijkstra  - shortestPath over tunnel states
+ * - classes   - classPath over speed classes of persons
+ * - fixed     - fixedPath with compile time solver for groups up to 16 persons
+ * - large     - largePath, rounds of masks of any width
+ * - fast      - fastPath over sorted speeds
+ *
+ * Output is tab separated, one line for every group and stage in fixed order, with header line. Columns are group size,
+ * distribution, stage, status (ok, truncated or skipped), items (rows, edges or paths), result (total speed of the
+ * quickest path when stage finds it), seconds, number and bytes of heap allocations and peak resident memory in kB.
+ * Everything except seconds and memory columns is same on every run, so outputs of two versions can be compared with diff.
+ *
+ * Build: g++ -std=c++17 -O2 -pthread bench.cpp -o tunnel_bench
+ */
+
+#include "tunnel.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+#include <sys/resource.h>
+
+
+static std::atomic<std::size_t> g_allocations(0);        /**< number of calls of operator new*/
+static std::atomic<std::size_t> g_allocated_bytes(0);    /**< bytes requested from operator new*/
+
+void* operator new(std::size_t size)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    g_allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+
+    void *p_memory = std::malloc(size ? size : 1);
+    if (p_memory == nullptr)
+        throw std::bad_alloc();
+    return p_memory;
+}
+
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"     /**< gcc sees malloc() of replaced operator new*/
+#endif
+
+void operator delete(void *p_memory) noexcept { std::free(p_memory); }
+void operator delete(void *p_memory, std::size_t) noexcept { std::free(p_memory); }
+
+
+/**@brief Structure which contains measurement of one stage*/
+struct StageResult
+{
+    std::string status = "ok";       /**< ok, truncated when limit is reached, skipped when stage is not run*/
+    std::size_t items = 0;           /**< rows, edges or paths that stage made*/
+    unsigned long long result = 0;   /**< total speed of the quickest path, 0 when stage does not find it*/
+    double seconds = 0;              /**< wall time of the stage*/
+    std::size_t allocations = 0;     /**< number of heap allocations*/
+    std::size_t bytes = 0;           /**< bytes of heap allocations*/
+    long peak_rss_kb = 0;            /**< peak resident memory of the process after the stage*/
+};
+
+/**@brief Structure which contains options of the benchmark given from command line*/
+struct BenchOptions
+{
+    unsigned min_n = 3;                                   /**< smallest group*/
+    unsigned max_n = 20;                                  /**< biggest group*/
+    unsigned repeat = 1;                                  /**< runs of every group, shortest time is reported*/
+    double scan_budget = 1e9;                             /**< maximal number of compared row pairs for scan*/
+    std::size_t path_limit = 1000000;                     /**< maximal number of sorted paths*/
+    std::vector<std::string> distributions{"uniform", "skewed", "duplicate"};
+    std::string output;                                   /**< output file, empty - standard output*/
+};
+
+
+/**
+ * @brief resetPeakMemory() function resets peak resident memory of the process, if system allows it.
+ */
+void resetPeakMemory()
+{
+    std::ofstream clear_refs("/proc/self/clear_refs");
+    if (clear_refs)
+        clear_refs << "5";
+}
+
+/**
+ * @brief peakMemory() function returns peak resident memory of the process in kB.
+ */
+long peakMemory()
+{
+    std::ifstream status("/proc/self/status");
+    for (std::string line; std::getline(status, line); )
+        if (line.compare(0, 6, "VmHWM:") == 0)
+            return std::stol(line.substr(6));
+
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+/**
+ * @brief measure() function runs stage and records its time, allocations and peak memory.
+ *
+ * @param stage function of the stage that fills items, result and status
+ * @return measurement of the stage
+ */
+template<typename Stage>
+StageResult measure(Stage stage)
+{
+    StageResult result;
+    resetPeakMemory();
+    const std::size_t allocations = g_allocations.load();
+    const std::size_t bytes = g_allocated_bytes.load();
+    const auto start = std::chrono::steady_clock::now();
+
+    stage(result);
+
+    result.seconds     = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    result.allocations = g_allocations.load() - allocations;
+    result.bytes       = g_allocated_bytes.load() - bytes;
+    result.peak_rss_kb = peakMemory();
+    return result;
+}
+
+/**
+ * @brief makeGroup() function creates group of persons with speeds from given distribution.
+ *
+ * Speeds are taken from std::mt19937 with seed made from group size and distribution, raw numbers of the generator are
+ * same on every platform, so groups are same on every run.
+ *
+ * @param number_of_persons size of group
+ * @param distribution uniform - speeds 1 to 100, skewed - most of speeds small and few big, duplicate - speeds 1, 2, 5, 10
+ * @return persons of the group
+ */
+std::vector<PersonInformation> makeGroup(const unsigned number_of_persons, const std::string &distribution)
+{
+    std::mt19937 random_generator(number_of_persons * 1000 + distribution.size());
+    std::vector<PersonInformation> persons(number_of_persons);
+    const unsigned duplicate_speeds[] = {1, 2, 5, 10};
+
+    for (unsigned i = 0; i < number_of_persons; i++)
+    {
+        const unsigned random = random_generator();
+        persons[i].name = "p" + std::to_string(i);
+
+        if (distribution == "skewed")
+            persons[i].speed = 1 + (random % 100) * (random % 100) * (random % 100) / 10000;
+        else if (distribution == "duplicate")
+            persons[i].speed = duplicate_speeds[random % 4];
+        else
+            persons[i].speed = 1 + random % 100;
+    }
+
+    return persons;
+}
+
+/**
+ * @brief benchGroup() function measures all stages on one group.
+ *
+ * @param persons persons of the group
+ * @param options options of the benchmark
+ * @return measurements of stages generate, scan, enumerate, minimum, bound, resolve, dijkstra, classes, fixed and fast
+ */
+std::vector<StageResult> benchGroup(std::vector<PersonInformation> &persons, const BenchOptions &options)
+{
+    const unsigned number_of_persons = persons.size();
+    const unsigned directions_number = number_of_persons - 1;
+    std::vector<StageResult> results;
+
+    edgeArena arena;
+    std::vector<solutionsGenerator> forward(directions_number);
+    std::vector<solutionsGenerator> backward(directions_number);
+    std::vector<vector_of_persons> vector_of_paths;
+
+    results.push_back(measure([&](StageResult &result)
+    {
+        for (unsigned i = 0; i < directions_number; i++)
+        {
+            forward[i](number_of_persons - i, i, persons.data(), arena);
+            backward[i](2 + i, number_of_persons - 2 - i, persons.data(), arena);
+            result.items += forward[i].rows() + backward[i].rows();
+        }
+    }));
+
+    double row_pairs = 0;
+    for (unsigned i = 0; i < directions_number; i++)
+    {
+        row_pairs += (double) forward[i].rows() * backward[i].rows();
+        if (i + 1 < directions_number)
+            row_pairs += (double) backward[i].rows() * forward[i + 1].rows();
+    }
+    const bool scan = row_pairs <= options.scan_budget;
+
+    results.push_back(measure([&](StageResult &result)
+    {
+        if (!scan)
+        {
+            result.status = "skipped";
+            return;
+        }
+        for (unsigned i = 0; i < directions_number; i++)
+        {
+            forward[i] >> backward[i];
+            result.items += forward[i].m_edges.offsets[forward[i].rows()];
+
+            if (i + 1 < directions_number)
+            {
+                backward[i] << forward[i + 1];
+                result.items += backward[i].m_edges.offsets[backward[i].rows()];
+            }
+        }
+    }));
+
+    results.push_back(measure([&](StageResult &result)
+    {
+        if (!scan)
+        {
+            result.status = "skipped";
+            return;
+        }
+        pathEnumerator paths(&forward[0]);
+        while (const vector_of_persons *p_path = paths.next())
+        {
+            if (vector_of_paths.size() == options.path_limit)
+            {
+                result.status = "truncated";
+                break;
+            }
+            vector_of_paths.push_back(*p_path);
+        }
+        result.items = vector_of_paths.size();
+    }));
+
+    results.push_back(measure([&](StageResult &result)
+    {
+        if (!scan)
+        {
+            result.status = "skipped";
+            return;
+        }
+        pathBuffer paths(vector_of_paths);
+        result.result = scheduleSpeed(minimumPath(paths));
+        result.items  = vector_of_paths.size();
+        if (vector_of_paths.size() == options.path_limit)
+            result.status = "truncated";
+    }));
+
+    results.push_back(measure([&](StageResult &result)
+    {
+        if (!scan)
+        {
+            result.status = "skipped";
+            return;
+        }
+        result.result = countPaths(&forward[0]).speed;
+        for (unsigned i = 0; i < directions_number; i++)
+            result.items += forward[i].edges() + backward[i].edges();
+    }));
+
+    results.push_back(measure([&](StageResult &result)
+    {
+        if (!scan)
+        {
+            result.status = "skipped";
+            return;
+        }
+        std::vector<PersonPointers> schedule = boundPath(&forward[0], persons.data(), number_of_persons);
+        result.items  = schedule.size();
+        result.result = scheduleSpeed(schedule);
+    }));
+
+    std::unique_ptr<incrementalSolver> incremental;
+    unsigned slowest = 0;
+    if (scan)
+    {
+        incremental.reset(new incrementalSolver(persons.data(), number_of_persons));
+        for (unsigned i = 1; i < number_of_persons; i++)
+            if (persons[i].speed > persons[slowest].speed)
+                slowest = i;
+    }
+    results.push_back(measure([&](StageResult &result)
+    {
+        if (!scan)
+        {
+            result.status = "skipped";
+            return;
+        }
+        incremental->setSpeed(slowest, persons[slowest].speed + 1);
+        result.items  = incremental->recomputed();
+        result.result = incremental->speed();
+    }));
+
+    results.push_back(measure([&](StageResult &result)
+    {
+        std::vector<PersonPointers> schedule = shortestPath(persons.data(), number_of_persons);
+        result.items  = schedule.size();
+        result.result = scheduleSpeed(schedule);
+    }));
+
+    results.push_back(measure([&](StageResult &result)
+    {
+        std::vector<PersonPointers> schedule = classPath(persons.data(), number_of_persons);
+        result.items  = schedule.size();
+        result.result = scheduleSpeed(schedule);
+    }));
+
+    results.push_back(measure([&](StageResult &result)
+    {
+        std::vector<PersonPointers> schedule = fixedPath(persons.data(), number_of_persons);
+        result.items  = schedule.size();
+        result.result = scheduleSpeed(schedule);
+    }));
+
+    results.push_back(measure([&](StageResult &result)
+    {
+        std::vector<PersonPointers> schedule = largePath(persons.data(), number_of_persons);
+        result.items  = schedule.size();
+        result.result = scheduleSpeed(schedule);
+    }));
+
+    results.push_back(measure([&](StageResult &result)
+    {
+        std::vector<PersonPointers> schedule = fastPath(persons.data(), number_of_persons);
+        result.items  = schedule.size();
+        result.result = scheduleSpeed(schedule);
+    }));
+
+    return results;
+}
+
+/**
+ * @brief parseBenchOptions() function reads command line arguments into BenchOptions
+ *
+ * @return true if all arguments are known
+ */
+bool parseBenchOptions(int argc, char *argv[], BenchOptions &options)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        std::string argument = argv[i];
+
+        if (argument.compare(0, 8, "--min-n=") == 0)
+        {
+            if (!parseNumber(argument.substr(8), options.min_n))
+                return false;
+        }
+        else if (argument.compare(0, 8, "--max-n=") == 0)
+        {
+            if (!parseNumber(argument.substr(8), options.max_n))
+                return false;
+        }
+        else if (argument.compare(0, 9, "--repeat=") == 0)
+        {
+            if (!parseNumber(argument.substr(9), options.repeat))
+                return false;
+        }
+        else if (argument.compare(0, 14, "--scan-budget=") == 0)
+        {
+            char *end = nullptr;
+            options.scan_budget = std::strtod(argument.c_str() + 14, &end);
+            if (end == argument.c_str() + 14 || *end != '\0')
+                return false;
+        }
+        else if (argument.compare(0, 13, "--path-limit=") == 0)
+        {
+            if (!parseNumber(argument.substr(13), options.path_limit))
+                return false;
+        }
+        else if (argument.compare(0, 16, "--distributions=") == 0)
+        {
+            options.distributions.clear();
+            std::istringstream list(argument.substr(16));
+            for (std::string distribution; std::getline(list, distribution, ','); )
+                options.distributions.push_back(distribution);
+        }
+        else if (argument.compare(0, 9, "--output=") == 0)
+            options.output = argument.substr(9);
+        else
+            return false;
+    }
+
+    return options.min_n >= 2 && options.min_n <= options.max_n && options.max_n < state_word_bits && options.repeat > 0;
+}
+
+int main(int argc, char *argv[])
+{
+    BenchOptions options;
+    if (!parseBenchOptions(argc, argv, options))
+    {
+        std::cerr << "usage: " << argv[0] << " [--min-n=3] [--max-n=20] [--repeat=1] [--scan-budget=1e9]"
+                  << " [--path-limit=1000000] [--distributions=uniform,skewed,duplicate] [--output=file]\n";
+        return 1;
+    }
+
+    std::ofstream output_file;
+    if (!options.output.empty())
+        output_file.open(options.output);
+    std::ostream &out = options.output.empty() ? std::cout : output_file;
+
+    const char *stages[] = {"generate", "scan", "enumerate", "minimum", "count", "bound", "resolve", "dijkstra", "classes", "fixed", "large", "fast"};
+
+    out << "n\tdistribution\tstage\tstatus\titems\tresult\tseconds\tallocations\tbytes\tpeak_rss_kb\n";
+    for (unsigned n = options.min_n; n <= options.max_n; n++)
+        for (auto &distribution : options.distributions)
+        {
+            std::vector<PersonInformation> persons = makeGroup(n, distribution);
+            std::vector<StageResult> best;
+
+            for (unsigned run = 0; run < options.repeat; run++)
+            {
+                std::vector<StageResult> results = benchGroup(persons, options);
+                if (best.empty())
+                    best = results;
+                for (std::size_t stage = 0; stage < results.size(); stage++)
+                    best[stage].seconds = std::min(best[stage].seconds, results[stage].seconds);
+            }
+
+            for (std::size_t stage = 0; stage < best.size(); stage++)
+                out << n << "\t" << distribution << "\t" << stages[stage] << "\t" << best[stage].status << "\t"
+                    << best[stage].items << "\t" << best[stage].result << "\t" << best[stage].seconds << "\t"
+                    << best[stage].allocations << "\t" << best[stage].bytes << "\t" << best[stage].peak_rss_kb << "\n";
+            out.flush();
+        }
+
+    return 0;
+}
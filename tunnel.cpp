@@ -9,7 +9,8 @@
  * This program solves the issue, which is the fastest way passing through a narrow dark tunnel for a number of people
  * with having only one flashlight. The tunnel can pass only two people at the same time and somebody has to go back
  * in order to return flashlight. Everyone has a certain speed, two people travel at the speed of those person that has
- * a lowest speed. Person that is returning back travel at his own speed.
+ * a lowest speed. Person that is returning back travel at his own speed. With option --capacity=k tunnel passes k people
+ * at the same time, k people go forward together (or all remaining people in the last move) at the lowest speed of them.
  * Although it seems that the solution for this problem can be easily solved with a recursive function, this program
  * represents a new way approach for this problem. Although the program uses a recursive function, it is used only to
  * summarize all the results of the solutions in vector of paths.
@@ -17,9 +18,8 @@
  * each way of the path, forward (two persons going), backward(one person returning). Program shows how we can transform
  * this problem in binary operations. For example if we have 3 persons that is on one side, lets say at beginning on tunnel
  * we can represent this with 111, if first two people cross on other side we can represent this as 110.
- * Program can do in theory bit shifting and bit operations to solve this problem, but for know we will simulate bits like
- * characters.
- * We will do same operation on bits with another program version.
+ * Program does this with bit shifting and bit operations, every row of solutions is packed in 64-bit words (one bit for
+ * every person, more words for bigger groups), so pattern match of two rows is OR, AND and popcount over few words.
  *
  * Let's see some examples:
  * 111 FO (beginning of the tunnel) forward->backward
@@ -53,470 +53,357 @@
  *
  */
 
+#include "tunnel.h"
+
+#include <cstdlib>
 #include <iostream>
+#include <fstream>
+#include <memory>
+#include <new>
 #include <string>
-#include <map>
-#include <vector>
-#include <utility>
-
+#include <thread>
 
 
+static std::atomic<bool> g_count_allocations(false);                /**< operator new counts allocations for stats*/
+static std::atomic<unsigned long long> g_allocations(0);            /**< number of calls of operator new*/
+static std::atomic<unsigned long long> g_allocated_bytes(0);        /**< bytes requested from operator new*/
 
-/**@brief Structure which contains information about the person*/
-struct PersonInformation
+void* operator new(std::size_t size)
 {
-    std::string name;
-    unsigned speed;
-};
+    if (g_count_allocations.load(std::memory_order_relaxed))
+    {
+        g_allocations.fetch_add(1, std::memory_order_relaxed);
+        g_allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+    }
 
-/**@brief Structure which contains pointers to information about the persons
- *
- * Purpose of this structure is to connect vector of paths to every user, we have two users here for backward->forward operation
- * when two people is returning, the lower speed is then assigned. For forward->backward operation on second name is nullptr*/
-struct PersonPointers
+    void *p_memory = std::malloc(size ? size : 1);
+    if (p_memory == nullptr)
+        throw std::bad_alloc();
+    return p_memory;
+}
+
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"     /**< gcc sees malloc() of replaced operator new*/
+#endif
+
+void operator delete(void *p_memory) noexcept { std::free(p_memory); }
+void operator delete(void *p_memory, std::size_t) noexcept { std::free(p_memory); }
+
+
+/**@brief Structure which contains options of the program given from command line*/
+struct ProgramOptions
 {
-    std::string *first_name = nullptr;
-    std::string *second_name = nullptr;
-    unsigned *speed = nullptr;
+    SolverSettings settings;            /**< solver (enumerate - print all paths and minimum, dijkstra - shortest path over
+                                             states, fast - closed form over sorted speeds, classes - shortest path over
+                                             speed classes, fixed - compile time solvers for 2 to 16 persons, bound -
+                                             branch and bound search over generators, large - rounds of masks of any
+                                             width) and capacity of the tunnel*/
+    unsigned self_check = 0;            /**< number of random groups for self check, 0 - no self check*/
+    bool batch = false;                 /**< read many groups without prompts, one group per line*/
+    std::string batch_file;             /**< file with groups for batch, empty - standard input*/
+    bool edits = false;                 /**< read groups and edits of groups, schedule after every line, only with
+                                             enumerate solver and capacity two of incrementalSolver*/
+    std::string edits_file;             /**< file with groups and edits, empty - standard input*/
+    unsigned threads = std::thread::hardware_concurrency();  /**< number of threads for batch*/
+    std::size_t top_paths = 0;          /**< print only this number of quickest paths, 0 - print all paths*/
+    bool min_only = false;              /**< print only minimal path of enumeration*/
+    std::string dump_file;              /**< binary file for all enumerated paths, empty - no dump*/
+    unsigned parallel = 1;              /**< number of threads for scan and paths of one group*/
+    bool stats = false;                 /**< collect stage timers and counters*/
+    std::string stats_file;             /**< file for stats in JSON, empty - standard error*/
+    std::string cache_file;             /**< memory mapped file of minimal schedules, empty - no cache*/
+    unsigned cache_slots = 4096;        /**< number of schedules in new cache file*/
+    bool serve = false;                 /**< answer requests as server until end of input or stop signal*/
+    std::string serve_socket;           /**< path of Unix domain socket of server, empty - standard input and output*/
 };
 
-
 /**
- * @brief Class Person creates individual person and set persons name and speed.
- *
- * This class forms a array of Persons by the function enterUser(), array is provided from a structure PersonalInformation for
- * each user, pointer of array  mp_of_persons points to a individual structure which contains all information about the user.
- *
+ * @brief Class statsReport turns stats on and writes them as JSON when it is destroyed, so on every return from main.
  */
-class Person
+class statsReport
 {
-    unsigned m_number_of_persons;
-    PersonInformation *mp_of_persons; /**< pointer to array of structure PersonInformation*/
+    const ProgramOptions &m_options;      /**< options with stats file*/
 
 public:
 
-    /** @brief Function returns a number of Persons.
-     *  @param no parameters
-     *  @return returns the number of persons*/
-    unsigned numberOfPeople() {return m_number_of_persons;}
-
-    /** @brief Constructor of a class Person*/
-    Person() : m_number_of_persons(0), mp_of_persons(nullptr) {}
-
-    /** @brief Destructor of a class Person*/
-    ~Person() { delete[] mp_of_persons;}
-
-    /** @brief Overloading operator[] that returns from arrays index structure of PersonInformation*/
-    const PersonInformation& operator[] (const unsigned index)
+    /** @brief Constructor of a class turns stats and counting of allocations on if options ask for stats.*/
+    explicit statsReport(const ProgramOptions &options) : m_options(options)
     {
-        return mp_of_persons[index];
+        stats().enable(options.stats);
+        g_count_allocations = options.stats;
     }
 
-    /**
-     * @brief Function enterUser() takes the the number of persons and fills persons data, name and speed and then returns
-     * array of Persons information to the private member mp_of_persons, pointer to array of structure PersonInformation.
-     *
-     * @param no parameter
-     * @return no return
-     *
-     */
-    void enterUser()
+    /** @brief Destructor of a class writes stats on standard error or in stats file.*/
+    ~statsReport()
     {
+        if (!m_options.stats)
+            return;
 
-        unsigned number_of_persons;
-
-        std::cout << "\nEnter number of Persons:";
-        std::cin >> number_of_persons;
-
+        stats().add(solverStats::counter_allocations, g_allocations.load());
+        stats().add(solverStats::counter_allocated_bytes, g_allocated_bytes.load());
 
-        mp_of_persons = new PersonInformation[number_of_persons];
-        m_number_of_persons = number_of_persons;
-
-        for (unsigned i = 0; i < number_of_persons; i++)
+        if (m_options.stats_file.empty())
         {
-            std::cout << "\nEnter name of Person:";
-            std::cin >> mp_of_persons[i].name;
-            std::cout << "\nEnter speed of Person:";
-            std::cin >> mp_of_persons[i].speed;
+            stats().writeJson(std::cerr);
+            return;
         }
-    }
-    /**
-     * @brief Function personsInformation() returns a pointer to array of structure PersonInformation
-     *
-     * @param no parameters
-     * @return pointer to array of structure PersonInformation
-     */
-    PersonInformation* personsInformation()
-    {
-        return mp_of_persons;
-    }
 
+        std::ofstream stats_file(m_options.stats_file);
+        stats().writeJson(stats_file);
+    }
 
+    statsReport(const statsReport&) = delete;
+    statsReport& operator= (const statsReport&) = delete;
 };
 
-
-
-
-using bit = char;               /**< simulating character like a bit, char '1', char '0'*/
-using map_path_row = unsigned;  /**< key value of map pointer m_map_path_speed*/
-
-
 /**
- * @brief Class solutionsGenerator generates all possible solutions from ones and zeros ('1' and '0').
+ * @brief parseOptions() function reads command line arguments into ProgramOptions
  *
- * Class defines method for making a matrix of all possible solutions with logical ones and zeros.
- * Constructor of the class receives the number of logical ones and zeros, addition of this two
- * parameters give the class number of columns, and number of rows depends on the number of
- * all possible solutions. The goal is to from a given parameters make a matrix, two dimensional
- * array with all solutions.
+ * @param argc number of arguments
+ * @param argv arguments
+ * @param options reference in which are recorded options
+ * @return true if all arguments are known
  */
-class solutionsGenerator
+bool parseOptions(int argc, char *argv[], ProgramOptions &options)
 {
-    unsigned m_matrix_rows;                  /**< number of rows for two-dimensional arrays*/
-    unsigned m_matrix_columns;               /**< number of columns for two-dimensional arrays*/
-    unsigned m_number_of_ones;               /**< number of logical ones '1' defined in class constructor*/
-    bit **mp_matrix;                         /**< double pointer points to two-dimensional array(matrix) of generated solutions*/
-    PersonInformation *pointer_of_persons;   /**< pointer to array of structure PersonInformation*/
-
-public:
-
-    std::map<map_path_row, PersonPointers*> *m_map_path_speed;  /**< map for entering rows that connect path and info about travelers*/
-    solutionsGenerator *mp_next;                                /**< pointer to the next solution generator connected via << and >> operators*/
-
+    for (int i = 1; i < argc; i++)
+    {
+        std::string argument = argv[i];
 
-    /** @brief Constructor of a class.*/
-    solutionsGenerator()
-    : m_matrix_rows(0), m_matrix_columns(0), m_number_of_ones(0), mp_matrix(nullptr),
-      pointer_of_persons(nullptr), m_map_path_speed(nullptr), mp_next(nullptr) {}
+        if (argument.compare(0, 9, "--solver=") == 0)
+            options.settings.solver = argument.substr(9);
+        else if (argument.compare(0, 11, "--capacity=") == 0)
+        {
+            if (!parseNumber(argument.substr(11), options.settings.capacity))
+                return false;
+        }
+        else if (argument == "--self-check")
+            options.self_check = 1000;
+        else if (argument.compare(0, 13, "--self-check=") == 0)
+        {
+            if (!parseNumber(argument.substr(13), options.self_check))
+                return false;
+        }
+        else if (argument == "--edits")
+            options.edits = true;
+        else if (argument.compare(0, 8, "--edits=") == 0)
+        {
+            options.edits = true;
+            options.edits_file = argument.substr(8);
+        }
+        else if (argument == "--batch")
+            options.batch = true;
+        else if (argument.compare(0, 8, "--batch=") == 0)
+        {
+            options.batch = true;
+            options.batch_file = argument.substr(8);
+        }
+        else if (argument.compare(0, 10, "--threads=") == 0)
+        {
+            if (!parseNumber(argument.substr(10), options.threads))
+                return false;
+        }
+        else if (argument.compare(0, 6, "--top=") == 0)
+        {
+            if (!parseNumber(argument.substr(6), options.top_paths))
+                return false;
+        }
+        else if (argument.compare(0, 11, "--parallel=") == 0)
+        {
+            if (!parseNumber(argument.substr(11), options.parallel))
+                return false;
+        }
+        else if (argument == "--stats")
+            options.stats = true;
+        else if (argument.compare(0, 8, "--stats=") == 0)
+        {
+            options.stats = true;
+            options.stats_file = argument.substr(8);
+        }
+        else if (argument.compare(0, 8, "--cache=") == 0)
+            options.cache_file = argument.substr(8);
+        else if (argument.compare(0, 14, "--cache-slots=") == 0)
+        {
+            if (!parseNumber(argument.substr(14), options.cache_slots))
+                return false;
+        }
+        else if (argument == "--min-only")
+            options.min_only = true;
+        else if (argument.compare(0, 7, "--dump=") == 0)
+            options.dump_file = argument.substr(7);
+        else if (argument.compare(0, 8, "--spill=") == 0)
+            options.settings.spill_file = argument.substr(8);
+        else if (argument == "--count")
+            options.settings.count = true;
+        else if (argument == "--format=text")
+            options.settings.format = format_text;
+        else if (argument == "--format=csv")
+            options.settings.format = format_csv;
+        else if (argument == "--format=ndjson")
+            options.settings.format = format_ndjson;
+        else if (argument == "--serve")
+            options.serve = true;
+        else if (argument.compare(0, 8, "--serve=") == 0)
+        {
+            options.serve = true;
+            options.serve_socket = argument.substr(8);
+        }
+        else
+            return false;
+
+        if (options.settings.solver != "enumerate" && options.settings.solver != "dijkstra" && options.settings.solver != "fast" &&
+            options.settings.solver != "classes" && options.settings.solver != "fixed" && options.settings.solver != "bound" &&
+            options.settings.solver != "large")
+            return false;
+        if (options.settings.capacity < 2)
+            return false;
+    }
 
-    /** @brief Destructor of a class.*/
-    ~solutionsGenerator() { for(unsigned i = 0; i < m_matrix_rows; i++) delete[] mp_matrix[i]; }
+    if (options.edits && (options.settings.solver != "enumerate" || options.settings.capacity != 2 || options.settings.count))
+        return false;                                   /**< incrementalSolver keeps generator chain of capacity two*/
 
+    return true;
+}
 
-    /** @brief Class operator() from parameters input create possible solution matrix.
-     *
-     * This overloading operator from its parameters create an matrix, two-dimensional array of all combinations zeros
-     * and ones. This is achieved with for loops that creates first row and then by modifying previous rows creates
-     * a matrix, ie. two-dimensional array.
-     *
-     *  @param number_of_ones receives number of logical ones
-     *  @param number_of_zeros receives number of logical zeros
-     *  @param p_of_persons creates a link to the array pointer for structure PersonInformation
-     * */
-    solutionsGenerator& operator() (const unsigned number_of_ones, const unsigned number_of_zeros, PersonInformation *p_of_persons)
+int main(int argc, char *argv[])
+{
+    ProgramOptions options;
+    if (!parseOptions(argc, argv, options))
     {
-        m_matrix_rows    = number_of_ones * number_of_zeros + 1;
-        m_matrix_columns = number_of_ones + number_of_zeros,
-                m_number_of_ones = number_of_ones;
-        mp_matrix        = new bit*[m_matrix_rows];        /**< creation of two dimensional array pointers*/
-        pointer_of_persons = p_of_persons;
-
-        m_map_path_speed = new std::map<map_path_row, PersonPointers*>[m_matrix_rows];
-
-        for (unsigned i = 0; i < m_matrix_rows; i++)
-            mp_matrix[i] = new bit[m_matrix_columns];            /**< insert in each row new columns*/
-
-        for (unsigned i = 0; i < m_matrix_columns; i++)
-            mp_matrix[0][i] = i < m_number_of_ones ? '1' : '0';  /**< generating first row*/
+        std::cerr << "usage: " << argv[0] << " [--solver=enumerate|dijkstra|fast|classes|fixed|bound|large] [--capacity=k] [--self-check[=groups]]"
+                  << " [--batch[=file]] [--edits[=file]] [--threads=n] [--top=k] [--parallel=n] [--stats[=file]]"
+                  << " [--cache=file] [--cache-slots=n] [--serve[=socket]] [--min-only] [--format=text|csv|ndjson]"
+                  << " [--dump=file] [--spill=file] [--count]\n";
+        return 1;
+    }
 
+    statsReport report(options);                           /**< writes stats at the end of main*/
 
-        for (unsigned i = 1; i < m_matrix_rows; i++)            /**< generating rows after first one*/
+    std::unique_ptr<scheduleCache> cache;
+    if (!options.cache_file.empty() || options.serve)     /**< server keeps schedules in memory without cache file*/
+    {
+        cache.reset(new scheduleCache(options.cache_file, options.cache_slots));
+        if (!cache->isOpen())
         {
-            for (unsigned j = 0; j < m_matrix_columns; j++)
-                mp_matrix[i][j] = mp_matrix[ i - 1 ][j];       /**< copy row before*/
-
-            for (int k = (int) m_matrix_columns - 1; k >= 0 ; k--)
-                if (mp_matrix[i][k - 1] == '1' && mp_matrix[i][k] == '0') /**< bit generation through bit change order */
-                {
-                    mp_matrix[i][k - 1] = '0';
-                    mp_matrix[i][k]     = '1';
-                    break;
-                }
+            std::cerr << "cannot open " << options.cache_file << "\n";
+            return 1;
         }
-
-        return *this;
+        options.settings.cache = cache.get();
     }
 
-    /**
-     * @brief Class operator>> receives as parameter another class of solutionsGenerator for forward backward scan
-     *
-     * This class operator scan two solutionsGenerators, this pointer generator and rhs generator. This is forward backward
-     * operation that loops through rows from both generators looking for a pattern match. After pattern match is found
-     * in both rows possible path is then recorded in map m_map_path_speed. In map we are putting in which rhs index row is
-     * pattern found, and from given patterns we found users that are traveling and record in a map by value pointer to
-     * this users.
-     *
-     * @param rhs parameter, right hand side generator reference
-     */
-    void operator>> (solutionsGenerator &rhs)
+    if (options.serve)
     {
-        mp_next = &rhs;                                            /**< pointer that connect this pointer generator to rhs generator*/
-
-        for(unsigned i = 0; i < m_matrix_rows; i++)                /**< checks all rows from this pointer matrix*/
+        stats().enable(true);                             /**< counters for "stats" request*/
+        options.settings.server_limits = true;            /**< generator chain of one request is bounded*/
+        solverServer server(options.settings, options.threads);
+        bool served = options.serve_socket.empty() ? server.serveStream() : server.serveSocket(options.serve_socket);
+        if (!served)
         {
-            for(unsigned k = 0; k < rhs.m_matrix_rows; k++)        /**< checks all rows from rhs reference matrix*/
-            {
-                bool found_zero = false;                           /** tree bool variable for checking if in each row from *this matrix */
-                bool found_first_one = false;                      /** and rhs matrix is there a pattern that loops are looking through columns,*/
-                bool found_second_one = false;                     /** pattern must be two ones in same column, if its zeros abort scanning, no match*/
-                unsigned column_of_first_person;
-                unsigned column_of_second_person;
-
-                for(unsigned j = 0; j < m_matrix_columns; j++)         /**< checks all columns from this pointer matrix*/
-                {
-                    if (mp_matrix[i][j] == '0' && rhs.mp_matrix[k][j] == '0')  /**< checks zero '0' match in same column index*/
-                    {
-                        found_zero = true;
-                        break;
-                    }
-
-                    if (mp_matrix[i][j] == '1' && rhs.mp_matrix[k][j] == '1') /**< checks one '1' match in same column index*/
-                    {
-                        if (found_first_one)
-                        {
-                            column_of_second_person = j;
-                            found_second_one = true;
-                        }
-                        else
-                        {
-                            column_of_first_person = j;
-                            found_first_one = true;
-                        }
-                    }
-                }
-
-                if (!found_zero && found_second_one)    /**< if no '0' and two '1' are found then record rhs row in which is found and persons data*/
-                {
-                    PersonPointers *temp = new PersonPointers;
-                    temp->first_name  = &pointer_of_persons[column_of_first_person].name;
-                    temp->second_name = &pointer_of_persons[column_of_second_person].name;
-
-                    unsigned speed_column_check                                                                           /*< put lower speed**/
-                    = pointer_of_persons[column_of_first_person].speed > pointer_of_persons[column_of_second_person].speed
-                    ? column_of_first_person : column_of_second_person;
-                    temp->speed = &pointer_of_persons[speed_column_check].speed;
-
-                    m_map_path_speed[i][k] = temp;                               /**< put in map rhs rows (k) by key and persons data by value*/
-                                                                                 /**< value i is index of this pointer matrix row thats compared*/
-                }
-            }
+            std::cerr << "cannot listen on " << options.serve_socket << "\n";
+            return 1;
         }
-
+        return 0;
     }
 
-    /**
-     * @brief Class operator<< receives as parameter another class of solutionsGenerator for backward forward scan
-     *
-     * This class operator scan two solutionsGenerators, this pointer generator and rhs generator. This is backward forward
-     * operation that loops through rows from both generators looking for a pattern match. After pattern match is found
-     * in both rows possible path is then recorded in map m_map_path_speed. In map we are putting in which rhs index row is
-     * pattern found, and from given patterns we found users that are traveling and record in a map by value pointer to
-     * this user.
-     *
-     * @param rhs parameter, right hand side generator reference
-     */
-    void operator<< (solutionsGenerator &rhs)
+    if (options.edits)
     {
-
-        mp_next = &rhs;                                            /**< pointer that connect this pointer generator to rhs generator*/
-
-        for(unsigned i = 0; i < m_matrix_rows; i++)                /**< checks all rows from this pointer matrix*/
+        std::ios::sync_with_stdio(false);
+        if (options.edits_file.empty())
         {
-            for(unsigned k = 0; k < rhs.m_matrix_rows; k++)        /**< checks all rows from rhs reference matrix*/
-            {
-                bool found_zero = false;                           /** tree bool variable for checking if in each row from *this matrix */
-                bool found_one = false;                      /** and rhs matrix is there a pattern that loops are looking through columns,*/
-                unsigned column_of_first_person;
-
-                for(unsigned j = 0; j < m_matrix_columns; j++)         /**< checks all columns from this pointer matrix*/
-                {
-                    if (mp_matrix[i][j] == '0' && rhs.mp_matrix[k][j] == '0')  /**< checks zero '0' match in same column index*/
-                    {
-                        found_zero = true;
-                        break;
-                    }
-
-                    if (mp_matrix[i][j] == '1' && rhs.mp_matrix[k][j] == '1') /**< checks one '1' match in same column index*/
-                    {
-                        column_of_first_person = j;
-                        found_one = true;
-                    }
-                }
-
-                if (!found_zero && found_one) /**< if no '0' and one '1' are found then record rhs row in which is found and persons data*/
-                {
-                    PersonPointers *temp = new PersonPointers;
-                    temp->first_name  = &pointer_of_persons[column_of_first_person].name;
-                    temp->speed       = &pointer_of_persons[column_of_first_person].speed;
-                    m_map_path_speed[i][k] = temp;                            /**< put in map rhs rows (k) by key and persons data by value*/
-                                                                              /**< value i is index of this pointer matrix row thats compared*/
-                }
-            }
+            runEdits(std::cin, std::cout, options.settings.format);
+            return 0;
         }
 
-    }
-
-
-    /** @brief Function matrix() returns a double pointer mp_matrix.*/
-    bit** matrix() { return mp_matrix; }
-
-    /** @brief Function rows() returning number of rows in matrix.*/
-    unsigned rows() {return m_matrix_rows;};
-
-    /** @brief Function columns() returning number of columns in matrix.*/
-    unsigned columns() {return m_matrix_columns;};
-
-};
-
-
-using vector_of_persons = std::vector<PersonPointers*>;
-/**
- * @brief pathSortingFunction() recursive function sort all possibilities from generated matrices and from theirs map entries
- *
- * This function sort in pth_vector all possible solutions from recursion method that operates on solutionsGenerator pointer
- * start. This pointer is first of many pointers that goes from each one generated matrices ie. generators, the information
- * from each generator is connected and put in vector for easier looping through iterator.
- *
- * @param start is a pointer that points to solutionsGenerator generator
- * @param pth_vector is a vector of vectors reference in which will be recorded all possible solutions
- * @param dir_number is reference of half number directions through tunnel
- *
- * @return no return
- * */
-
-void pathSortingFunction(const unsigned i, solutionsGenerator *start, std::vector<vector_of_persons> &pth_vector, const unsigned &dir_number)
-{
-    static bool end;                                 /**< designate end of recursion*/
-    static vector_of_persons temp_path_vec;          /**< temporary path for recursion method*/
-    static unsigned temp_vec_row = 0;                /**< iteration through recursion*/
-
-    if(start != nullptr)
-        for(auto &it : start->m_map_path_speed[i])   /**< i is row from m_map_path_speed*/
+        std::ifstream edits_file(options.edits_file);
+        if (!edits_file)
         {
-            temp_path_vec.resize(temp_vec_row);      /**< resize vector of persons when its iteration from recursion decreases*/
-            temp_path_vec.push_back(it.second);      /**< push back person(s) name and speed*/
-            end = true;
-            ++temp_vec_row;
-            pathSortingFunction(it.first, start->mp_next, pth_vector, dir_number);    /**recursion*/
-            --temp_vec_row;
-            if(end && ((dir_number*2 - 2) == temp_vec_row)) /**< if end of solutions and end of direction path */
-            {
-                pth_vector.push_back(temp_path_vec);        /**< on end of recursion push back persons path data */
-            }
-            end = false;
+            std::cerr << "cannot open " << options.edits_file << "\n";
+            return 1;
         }
-}
-
-/**
- * @brief printMinimum() function prints on screen all paths and then minimum needed path through iteration of persons vector
- *
- * @param v_of_paths contains all path solutions
- * @return no return
- */
-void printMinimum(std::vector<vector_of_persons> &v_of_paths)
-{
-    unsigned minimal_speed = 0;
-    std::vector<PersonPointers*> min_vector_of_paths;
-
+        runEdits(edits_file, std::cout, options.settings.format);
+        return 0;
+    }
 
-    for (auto &it : v_of_paths)              /**< vector rows iteration*/
+    if (options.batch)
     {
-        unsigned total_speed = 0;
-
-        for (auto &itb : it)
-        {
-            if(itb->second_name != nullptr)  /**< path iteration*/
-                std::cout << "->";
-            else
-                std::cout << "<-";
-
-            std::cout << *itb->first_name;
-            if(itb->second_name != nullptr)
-                std::cout << "-" << *itb->second_name;
-            std::cout << " " << *itb->speed << " ";
-            total_speed += *itb->speed;
-        }
-        if(minimal_speed == 0)
+        std::ios::sync_with_stdio(false);
+        if (options.batch_file.empty())
         {
-            minimal_speed = total_speed;
-            min_vector_of_paths = it;
+            runBatch(std::cin, std::cout, options.settings, options.threads);
+            return 0;
         }
-        else if(minimal_speed > total_speed)
+
+        std::ifstream batch_file(options.batch_file);
+        if (!batch_file)
         {
-            minimal_speed = total_speed;
-            min_vector_of_paths = it;
+            std::cerr << "cannot open " << options.batch_file << "\n";
+            return 1;
         }
-        std::cout << "** total speed: " << total_speed << " **\n";
+        runBatch(batch_file, std::cout, options.settings, options.threads);
+        return 0;
     }
 
-    unsigned min_speed = 0;
-
-    std::cout << "\n***minimal speed ***" << "\n";
-    for (auto &it : min_vector_of_paths)
+    if (options.self_check > 0)
     {
-        if(it->second_name != nullptr)
-            std::cout << "->";
-        else
-            std::cout << "<-";
-
-        std::cout << *it->first_name;
-        if(it->second_name != nullptr)
-            std::cout << "-" << *it->second_name;
-        std::cout << " " << *it->speed << " ";
-        min_speed += *it->speed;
+        unsigned mismatches = selfCheck(options.self_check);
+        std::cout << "self check: " << options.self_check << " groups, " << mismatches << " mismatches\n";
+        return mismatches == 0 ? 0 : 1;
     }
 
-    std::cout << "** minimal speed: " << min_speed << " **\n";
-}
-
-int main()
-{
-
     Person Persons;
     Persons.enterUser();
+    stats().add(solverStats::counter_instances, 1);
 
-    unsigned directions_number = (Persons.numberOfPeople() - 1);  /**< half number of directions through tunnel*/
-
-    /**< two way direction*/
-    solutionsGenerator forward[directions_number];
-    solutionsGenerator backward[directions_number];
-
-    unsigned f_pattern_one  = Persons.numberOfPeople();    /**< number of patterns '1' thats decreasing*/
-    unsigned f_pattern_zero = 0;                           /**< number of patterns '0' thats increasing*/
-    unsigned b_pattern_one = 2;                            /**< number of patterns '1' thats increasing*/
-    unsigned b_pattern_zero = Persons.numberOfPeople() - 2;/**< number of patterns '0' thats decreasing*/
-
-
-    /**< loop for creating all possible solution matrices for each direction forward and backwards*/
-    for (unsigned i = 0; i < directions_number; i++)
+    if (options.settings.count)                           /**< numbers of paths without enumeration*/
     {
-        forward[i](f_pattern_one--, f_pattern_zero++, Persons.personsInformation());
-        backward[i](b_pattern_one++, b_pattern_zero--, Persons.personsInformation());
+        generatorChain chain(Persons.personsInformation(), Persons.numberOfPeople(), options.parallel, options.settings.capacity);
+        std::string buffer;
+        appendCounts(buffer, countPaths(chain.start()), options.settings.format);
+        std::cout.write(buffer.data(), buffer.size());
+        return 0;
     }
 
-    /**< connect matrices(generators), and scan them with operators >> and <<  */
-    for (unsigned i = 0; i < directions_number; i++)
+    if (options.settings.solver != "enumerate")
     {
-        forward[i] >> backward[i];
-
-        if ( (i + 1) < directions_number)
-            backward[i] << forward[i + 1];
+        printSchedule(solveGroup(Persons.personsInformation(), Persons.numberOfPeople(), options.settings), options.settings.format);
+        return 0;
     }
 
+    generatorChain chain(Persons.personsInformation(), Persons.numberOfPeople(), options.parallel, options.settings.capacity);
+    pathEnumerator enumerator(chain.start());             /**< start from first generated matrix*/
+    std::unique_ptr<parallelEnumerator> parallel;
 
-    solutionsGenerator *start = &forward[0];              /**< start from first generated matrix*/
-
-    std::vector<vector_of_persons> vector_of_paths;       /**< pointer that connect this pointer generator with rhs generator*/
-
-
-    for(unsigned i = 0; i < start->rows(); i++)
-        pathSortingFunction(i, start, vector_of_paths, directions_number);
-
+    pathSource *paths = &enumerator;
+    if (options.parallel > 1 && (!options.dump_file.empty() || (!options.min_only && options.top_paths == 0)))
+    {
+        parallel.reset(new parallelEnumerator(chain.start(), options.parallel));   /**< buffers of tasks in order*/
+        paths = parallel.get();
+    }
 
-    printMinimum(vector_of_paths);
+    if (!options.dump_file.empty())
+    {
+        pathDump dump(options.dump_file, Persons.personsInformation(), Persons.numberOfPeople(), options.settings.capacity,
+                      2 * generatorChain::directions(Persons.numberOfPeople(), options.settings.capacity) - 1);
+        std::vector<PersonPointers> schedule = dumpPaths(*paths, dump);
+        if (!dump.finish())
+        {
+            std::cerr << "cannot write " << options.dump_file << "\n";
+            return 1;
+        }
+        printSchedule(schedule, options.settings.format);
+    }
+    else if (options.min_only && options.parallel > 1)       /**< every worker keeps its own minimum*/
+        printSchedule(parallelMinimum(chain.start(), options.parallel), options.settings.format);
+    else if (options.min_only)
+        printSchedule(minimumPath(*paths), options.settings.format);
+    else if (options.top_paths > 0 && options.parallel > 1)  /**< every worker keeps its own heap*/
+        printRanked(parallelCheapest(chain.start(), options.parallel, options.top_paths));
+    else if (options.top_paths > 0)
+        printCheapest(*paths, options.top_paths);
+    else
+        printMinimum(*paths);
 
 
 
     return 0;
 }
-
@@ -0,0 +1,5411 @@
+/**
+ * @file tunnel.h
+ * @author Dragoslav Rakić (dragoslav_rakic@outlook.com)
+ * @date 15, February, 2017
+ * @brief Persons, solution generators and solvers of the tunnel problem, used by tunnel program and its benchmark.
+ *
+ * Description of the problem and of the generators is in tunnel.cpp.
+ */
+
+#ifndef TUNNEL_H
+#define TUNNEL_H
+
+#include <iostream>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <cstdio>
+#include <vector>
+#include <utility>
+#include <unordered_map>
+#include <queue>
+#include <functional>
+#include <algorithm>
+#include <array>
+#include <random>
+#include <sstream>
+#include <fstream>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <deque>
+#include <memory>
+#include <chrono>
+#include <charconv>
+#include <condition_variable>
+#include <cerrno>
+#include <csignal>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+
+
+
+/**@brief Structure which contains information about the person*/
+struct PersonInformation
+{
+    std::string name;
+    unsigned speed;
+};
+
+/**@brief Structure which contains pointers to information about the persons
+ *
+ * Purpose of this structure is to connect vector of paths to every user, we have two users here for backward->forward operation
+ * when two people is returning, the lower speed is then assigned. For forward->backward operation on second name is nullptr.
+ * When tunnel carries more than two persons, third and further persons of the move are bits of other_persons*/
+struct PersonPointers
+{
+    std::string *first_name = nullptr;
+    std::string *second_name = nullptr;
+    unsigned *speed = nullptr;
+    PersonInformation *persons = nullptr;    /**< array of persons in which other_persons are columns*/
+    std::uint64_t other_persons = 0;         /**< bit j is person j that also goes forward, after first and second person*/
+};
+
+
+/**
+ * @brief Class Person creates individual person and set persons name and speed.
+ *
+ * This class forms a array of Persons by the function enterUser(), array is provided from a structure PersonalInformation for
+ * each user, pointer of array  mp_of_persons points to a individual structure which contains all information about the user.
+ *
+ */
+class Person
+{
+    unsigned m_number_of_persons;
+    PersonInformation *mp_of_persons; /**< pointer to array of structure PersonInformation*/
+
+public:
+
+    /** @brief Function returns a number of Persons.
+     *  @param no parameters
+     *  @return returns the number of persons*/
+    unsigned numberOfPeople() {return m_number_of_persons;}
+
+    /** @brief Constructor of a class Person*/
+    Person() : m_number_of_persons(0), mp_of_persons(nullptr) {}
+
+    /** @brief Destructor of a class Person*/
+    ~Person() { delete[] mp_of_persons;}
+
+    /** @brief Overloading operator[] that returns from arrays index structure of PersonInformation*/
+    const PersonInformation& operator[] (const unsigned index)
+    {
+        return mp_of_persons[index];
+    }
+
+    /**
+     * @brief Function enterUser() takes the the number of persons and fills persons data, name and speed and then returns
+     * array of Persons information to the private member mp_of_persons, pointer to array of structure PersonInformation.
+     *
+     * @param no parameter
+     * @return no return
+     *
+     */
+    void enterUser()
+    {
+
+        unsigned number_of_persons;
+
+        std::cout << "\nEnter number of Persons:";
+        std::cin >> number_of_persons;
+
+
+        mp_of_persons = new PersonInformation[number_of_persons];
+        m_number_of_persons = number_of_persons;
+
+        for (unsigned i = 0; i < number_of_persons; i++)
+        {
+            std::cout << "\nEnter name of Person:";
+            std::cin >> mp_of_persons[i].name;
+            std::cout << "\nEnter speed of Person:";
+            std::cin >> mp_of_persons[i].speed;
+        }
+    }
+    /**
+     * @brief Function personsInformation() returns a pointer to array of structure PersonInformation
+     *
+     * @param no parameters
+     * @return pointer to array of structure PersonInformation
+     */
+    PersonInformation* personsInformation()
+    {
+        return mp_of_persons;
+    }
+
+
+};
+
+
+
+
+using state_word = std::uint64_t; /**< one packed word of a state row, bit j of word w is the person in column w * 64 + j*/
+using map_path_row = unsigned;    /**< index of row in the next generator that edge leads to*/
+using person_index = std::uint16_t; /**< column of a person that travels on an edge*/
+
+const unsigned state_word_bits = 64;        /**< number of persons packed in one state_word*/
+const person_index no_person = 0xFFFF;      /**< second person of an edge when only one person is returning*/
+const unsigned chain_max_persons = 23;       /**< biggest group of generator chain, rows and edges of every generator
+                                                  fit in unsigned for any capacity*/
+
+
+/**
+ * @brief forEachCombination() function calls visit for every combination of travelers columns from array of columns
+ *
+ * Combination is a mask over indexes of columns and next mask is made with Gosper's hack: lowest one is carried up and
+ * ones below it are moved to the bottom, so every combination costs few operations and no rows are compared.
+ * There must be less than 64 columns.
+ *
+ * @param columns columns from which travelers are chosen, in ascending order
+ * @param number_of_columns number of columns in array
+ * @param travelers number of chosen columns
+ * @param visit function called with pointer to chosen columns, in ascending order
+ */
+template<typename Visit>
+inline void forEachCombination(const unsigned *columns, const unsigned number_of_columns, const unsigned travelers, Visit visit)
+{
+    if (travelers > number_of_columns || number_of_columns >= state_word_bits)
+        return;
+
+    unsigned chosen[state_word_bits];
+    const state_word limit = state_word(1) << number_of_columns;
+
+    for (state_word combination = (state_word(1) << travelers) - 1; combination < limit; )
+    {
+        unsigned found = 0;
+        for (state_word ones = combination; ones != 0; ones &= ones - 1)
+            chosen[found++] = columns[__builtin_ctzll(ones)];
+        visit(chosen);
+
+        if (combination == 0)
+            break;
+        const state_word lowest  = combination & (~combination + 1);
+        const state_word carried = combination + lowest;
+        combination = (((carried ^ combination) >> 2) / lowest) | carried;
+    }
+}
+
+/**
+ * @brief movePersons() function makes structure PersonPointers for persons in mask movers
+ *
+ * First and second person are two lowest columns, further persons are left in other_persons and speed points to the
+ * slowest person of the move.
+ *
+ * @param p_of_persons pointer to array of structure PersonInformation
+ * @param movers bit j is person j that moves, at least one person
+ * @return names and speed of persons of the move
+ */
+inline PersonPointers movePersons(PersonInformation *p_of_persons, const std::uint64_t movers)
+{
+    PersonPointers move;
+    move.persons = p_of_persons;
+
+    for (std::uint64_t ones = movers; ones != 0; ones &= ones - 1)
+    {
+        const unsigned column = __builtin_ctzll(ones);
+        if (move.first_name == nullptr)
+            move.first_name = &p_of_persons[column].name;
+        else if (move.second_name == nullptr)
+            move.second_name = &p_of_persons[column].name;
+        else
+            move.other_persons |= std::uint64_t(1) << column;
+
+        if (move.speed == nullptr || p_of_persons[column].speed > *move.speed)
+            move.speed = &p_of_persons[column].speed;                      /**< put lower speed*/
+    }
+
+    return move;
+}
+
+/**
+ * @brief moveColumns() function returns mask of persons of move, opposite of movePersons()
+ *
+ * @param move contains person(s) and speed of one move
+ * @param p_of_persons pointer to array of structure PersonInformation to which move points
+ * @param number_of_persons number of persons in array, less than 64
+ * @return bit j is person j that moves
+ */
+inline std::uint64_t moveColumns(const PersonPointers &move, const PersonInformation *p_of_persons, const unsigned number_of_persons)
+{
+    std::uint64_t movers = move.other_persons;
+    for (unsigned j = 0; j < number_of_persons; j++)
+        if (&p_of_persons[j].name == move.first_name || &p_of_persons[j].name == move.second_name)
+            movers |= std::uint64_t(1) << j;
+    return movers;
+}
+
+
+/**@brief Structure which contains matches of one row against a block of rows of the next generator*/
+struct rowMatches
+{
+    static constexpr unsigned block_rows = 64;      /**< rows of one block*/
+
+    std::uint64_t bitmap;                           /**< bit i is set when row i of the block matches*/
+    state_word movers[block_rows];                  /**< columns of persons that travel to row i*/
+    unsigned speed[block_rows];                     /**< speed of slowest person that travels to row i*/
+};
+
+/**
+ * @brief matchRowsScalar() function matches one single word row against block of rows of the next generator
+ *
+ * Rows of the next generator all have the same number of ones, so rows match when together they have a one in every
+ * column, persons that travel are then ones in both rows. Speed is computed only for matching rows.
+ *
+ * @param source row of this generator
+ * @param p_rows pointer to block of rows of the next generator
+ * @param number_of_rows rows in block, at most rowMatches::block_rows
+ * @param all_columns mask of all columns
+ * @param p_speeds pointer to array of speeds of persons by column
+ * @param matches structure in which bitmap, movers and speeds are recorded
+ */
+inline void matchRowsScalar(const state_word source, const state_word *p_rows, const unsigned number_of_rows,
+                            const state_word all_columns, const unsigned *p_speeds, rowMatches &matches)
+{
+    matches.bitmap = 0;
+    for (unsigned i = 0; i < number_of_rows; i++)
+    {
+        matches.movers[i] = source & p_rows[i];
+        if ((source | p_rows[i]) != all_columns)
+            continue;
+
+        matches.bitmap |= std::uint64_t(1) << i;
+        matches.speed[i] = 0;
+        for (state_word ones = matches.movers[i]; ones != 0; ones &= ones - 1)
+            matches.speed[i] = std::max(matches.speed[i], p_speeds[__builtin_ctzll(ones)]);
+    }
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+
+/** @brief matchRowsSse42() function is matchRowsScalar() with two rows in one SSE register.*/
+__attribute__((target("sse4.2")))
+inline void matchRowsSse42(const state_word source, const state_word *p_rows, const unsigned number_of_rows,
+                           const state_word all_columns, const unsigned *p_speeds, rowMatches &matches)
+{
+    const __m128i v_source = _mm_set1_epi64x((long long) source);
+    const __m128i v_all    = _mm_set1_epi64x((long long) all_columns);
+
+    matches.bitmap = 0;
+    unsigned i = 0;
+    for (; i + 2 <= number_of_rows; i += 2)
+    {
+        const __m128i v_rows   = _mm_loadu_si128((const __m128i*) (p_rows + i));
+        const __m128i v_movers = _mm_and_si128(v_source, v_rows);
+        const unsigned match   = _mm_movemask_pd(_mm_castsi128_pd(_mm_cmpeq_epi64(_mm_or_si128(v_source, v_rows), v_all)));
+        _mm_storeu_si128((__m128i*) (matches.movers + i), v_movers);
+        if (match == 0)
+            continue;
+
+        matches.bitmap |= (std::uint64_t) match << i;
+        __m128i v_speed = _mm_setzero_si128();                     /**< max over speeds of columns that travel*/
+        for (state_word ones = source; ones != 0; ones &= ones - 1)
+        {
+            const unsigned column = __builtin_ctzll(ones);
+            const __m128i v_bit   = _mm_set1_epi64x((long long) (state_word(1) << column));
+            const __m128i v_has   = _mm_cmpeq_epi64(_mm_and_si128(v_movers, v_bit), v_bit);
+            v_speed = _mm_max_epu32(v_speed, _mm_and_si128(v_has, _mm_set1_epi64x(p_speeds[column])));
+        }
+        matches.speed[i]     = (unsigned) _mm_cvtsi128_si32(v_speed);
+        matches.speed[i + 1] = (unsigned) _mm_extract_epi32(v_speed, 2);
+    }
+
+    rowMatches tail;
+    matchRowsScalar(source, p_rows + i, number_of_rows - i, all_columns, p_speeds, tail);
+    for (unsigned j = 0; i + j < number_of_rows; j++)
+    {
+        matches.movers[i + j] = tail.movers[j];
+        matches.speed[i + j]  = tail.speed[j];
+    }
+    matches.bitmap |= tail.bitmap << i;
+}
+
+/** @brief matchRowsAvx2() function is matchRowsScalar() with four rows in one AVX2 register.*/
+__attribute__((target("avx2")))
+inline void matchRowsAvx2(const state_word source, const state_word *p_rows, const unsigned number_of_rows,
+                          const state_word all_columns, const unsigned *p_speeds, rowMatches &matches)
+{
+    const __m256i v_source = _mm256_set1_epi64x((long long) source);
+    const __m256i v_all    = _mm256_set1_epi64x((long long) all_columns);
+
+    matches.bitmap = 0;
+    unsigned i = 0;
+    for (; i + 4 <= number_of_rows; i += 4)
+    {
+        const __m256i v_rows   = _mm256_loadu_si256((const __m256i*) (p_rows + i));
+        const __m256i v_movers = _mm256_and_si256(v_source, v_rows);
+        const unsigned match   = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(_mm256_or_si256(v_source, v_rows), v_all)));
+        _mm256_storeu_si256((__m256i*) (matches.movers + i), v_movers);
+        if (match == 0)
+            continue;
+
+        matches.bitmap |= (std::uint64_t) match << i;
+        __m256i v_speed = _mm256_setzero_si256();                  /**< max over speeds of columns that travel*/
+        for (state_word ones = source; ones != 0; ones &= ones - 1)
+        {
+            const unsigned column = __builtin_ctzll(ones);
+            const __m256i v_bit   = _mm256_set1_epi64x((long long) (state_word(1) << column));
+            const __m256i v_has   = _mm256_cmpeq_epi64(_mm256_and_si256(v_movers, v_bit), v_bit);
+            v_speed = _mm256_max_epu32(v_speed, _mm256_and_si256(v_has, _mm256_set1_epi64x(p_speeds[column])));
+        }
+        matches.speed[i]     = (unsigned) _mm256_extract_epi32(v_speed, 0);
+        matches.speed[i + 1] = (unsigned) _mm256_extract_epi32(v_speed, 2);
+        matches.speed[i + 2] = (unsigned) _mm256_extract_epi32(v_speed, 4);
+        matches.speed[i + 3] = (unsigned) _mm256_extract_epi32(v_speed, 6);
+    }
+
+    rowMatches tail;
+    matchRowsScalar(source, p_rows + i, number_of_rows - i, all_columns, p_speeds, tail);
+    for (unsigned j = 0; i + j < number_of_rows; j++)
+    {
+        matches.movers[i + j] = tail.movers[j];
+        matches.speed[i + j]  = tail.speed[j];
+    }
+    matches.bitmap |= tail.bitmap << i;
+}
+
+#endif
+
+using matchRowsFunction = void (*)(state_word, const state_word*, unsigned, state_word, const unsigned*, rowMatches&);
+
+/**
+ * @brief matchRowsKernel() function returns kernel for matching rows by name, or the best kernel of this processor
+ *
+ * @param name "scalar", "sse4.2", "avx2" or empty for the best kernel that processor supports
+ * @return kernel, nullptr when processor does not support kernel with the name
+ */
+inline matchRowsFunction matchRowsKernel(const std::string &name = std::string())
+{
+    if (name == "scalar")
+        return matchRowsScalar;
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_cpu_init();
+    if ((name.empty() || name == "avx2") && __builtin_cpu_supports("avx2"))
+        return matchRowsAvx2;
+    if ((name.empty() || name == "sse4.2") && __builtin_cpu_supports("sse4.2"))
+        return matchRowsSse42;
+#endif
+    return name.empty() ? matchRowsScalar : nullptr;
+}
+
+
+/**
+ * @brief Class solverStats collects stage timers and counters of the solver for monitoring.
+ *
+ * Stats are off by default. When they are off every timer and counter only checks one flag, so instrumented code has
+ * almost no overhead. Counters are atomic, so workers of batch and parallel modes can add to same stats.
+ * Stats are written as one JSON object with writeJson().
+ */
+class solverStats
+{
+public:
+
+    /** @brief Stages of the solver that are timed.*/
+    enum Stage { stage_generate, stage_scan, stage_enumerate, stage_print, stage_dijkstra, stage_fast, stage_batch,
+                 stage_classes, stage_fixed, stage_bound, stage_incremental, stage_large, stage_count,
+                 number_of_stages };
+
+    /** @brief Counters of the solver.*/
+    enum Counter { counter_instances, counter_states, counter_edges, counter_paths, counter_dijkstra_states,
+                   counter_dijkstra_edges, counter_arena_blocks, counter_arena_bytes, counter_allocations,
+                   counter_allocated_bytes, counter_cache_hits, counter_cache_misses, counter_cache_evictions,
+                   counter_class_states, counter_bound_rows, counter_bound_cuts, counter_incremental_rows,
+                   counter_large_states, counter_large_dropped, counter_count_edges, number_of_counters };
+
+private:
+
+    /**@brief Structure which contains rows and edges of generator on one position of the chain*/
+    struct GeneratorStats
+    {
+        bool forward;                /**< forward->backward or backward->forward generator*/
+        unsigned index;              /**< position of the generator in its direction*/
+        unsigned long long rows;     /**< rows of all generators on this position*/
+        unsigned long long edges;    /**< edges of all generators on this position*/
+    };
+
+    std::atomic<bool> m_enabled;                                          /**< stats are collected*/
+    std::atomic<unsigned long long> m_stage_nanoseconds[number_of_stages];  /**< wall time of every stage*/
+    std::atomic<unsigned long long> m_stage_calls[number_of_stages];        /**< number of runs of every stage*/
+    std::atomic<unsigned long long> m_counters[number_of_counters];         /**< values of counters*/
+
+    static const unsigned number_of_latency_buckets = 16 + 8 * 48;        /**< buckets of latency up to 2^52 microseconds*/
+    std::atomic<unsigned long long> m_latency[number_of_latency_buckets];  /**< number of requests in every latency bucket*/
+    std::mutex m_generators_lock;                                         /**< lock for m_generators*/
+    std::vector<GeneratorStats> m_generators;                             /**< rows and edges for every position of chain*/
+
+public:
+
+    /** @brief Constructor of a class, stats are off.*/
+    solverStats() : m_enabled(false)
+    {
+        for (auto &it : m_stage_nanoseconds) it = 0;
+        for (auto &it : m_stage_calls) it = 0;
+        for (auto &it : m_counters) it = 0;
+        for (auto &it : m_latency) it = 0;
+    }
+
+    /** @brief Function instance() returns stats of the process.*/
+    static solverStats& instance()
+    {
+        static solverStats stats;
+        return stats;
+    }
+
+    /** @brief Function enabled() returns true if stats are collected.*/
+    bool enabled() const { return m_enabled.load(std::memory_order_relaxed); }
+
+    /** @brief Function enable() turns collecting of stats on or off.*/
+    void enable(const bool enabled) { m_enabled.store(enabled, std::memory_order_relaxed); }
+
+    /** @brief Function add() adds value to counter.*/
+    void add(const Counter counter, const unsigned long long value)
+    {
+        if (enabled())
+            m_counters[counter].fetch_add(value, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Function latencyBucket() returns bucket of latency in microseconds.
+     *
+     * Latencies below 16 microseconds have own buckets, every bigger power of two is split in 8 buckets, so bucket is
+     * at most 12.5% wide.
+     */
+    static unsigned latencyBucket(const unsigned long long microseconds)
+    {
+        if (microseconds < 16)
+            return microseconds;
+        const unsigned exponent = 63 - __builtin_clzll(microseconds);
+        const unsigned bucket = 16 + (exponent - 4) * 8 + ((microseconds >> (exponent - 3)) & 7);
+        return bucket < number_of_latency_buckets ? bucket : number_of_latency_buckets - 1;
+    }
+
+    /** @brief Function bucketLatency() returns biggest latency in microseconds of bucket.*/
+    static unsigned long long bucketLatency(const unsigned bucket)
+    {
+        if (bucket < 16)
+            return bucket;
+        const unsigned exponent = (bucket - 16) / 8 + 4;
+        return ((8ULL + (bucket - 16) % 8 + 1) << (exponent - 3)) - 1;
+    }
+
+    /** @brief Function addLatency() adds one request of server that took nanoseconds from request to answer.*/
+    void addLatency(const unsigned long long nanoseconds)
+    {
+        m_latency[latencyBucket(nanoseconds / 1000)].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Function latency() returns latency in microseconds below which is fraction of requests.
+     *
+     * @param fraction fraction of requests, 0.5 for median, 0.99 for 99th percentile
+     * @return upper bound of bucket of the percentile, 0 if there were no requests
+     */
+    unsigned long long latency(const double fraction) const
+    {
+        unsigned long long requests = 0;
+        for (auto &it : m_latency)
+            requests += it.load(std::memory_order_relaxed);
+        if (requests == 0)
+            return 0;
+
+        const unsigned long long rank = (unsigned long long) (fraction * requests + 0.999999);
+        unsigned long long seen = 0;
+        for (unsigned i = 0; i < number_of_latency_buckets; i++)
+        {
+            seen += m_latency[i].load(std::memory_order_relaxed);
+            if (seen >= rank)
+                return bucketLatency(i);
+        }
+        return bucketLatency(number_of_latency_buckets - 1);
+    }
+
+    /** @brief Function addTime() adds one run of stage that took nanoseconds.*/
+    void addTime(const Stage stage, const unsigned long long nanoseconds)
+    {
+        m_stage_nanoseconds[stage].fetch_add(nanoseconds, std::memory_order_relaxed);
+        m_stage_calls[stage].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Function addGenerator() adds rows and edges of generator on position index of the chain.
+     *
+     * @param forward true for forward->backward generator
+     * @param index position of the generator in its direction
+     * @param rows rows of the generator
+     * @param edges edges recorded from the generator with operator >> or <<
+     */
+    void addGenerator(const bool forward, const unsigned index, const unsigned long long rows, const unsigned long long edges)
+    {
+        if (!enabled())
+            return;
+
+        add(counter_states, rows);
+        add(counter_edges, edges);
+
+        std::lock_guard<std::mutex> guard(m_generators_lock);
+        for (auto &it : m_generators)
+            if (it.forward == forward && it.index == index)
+            {
+                it.rows  += rows;
+                it.edges += edges;
+                return;
+            }
+        m_generators.push_back(GeneratorStats{forward, index, rows, edges});
+    }
+
+    /**
+     * @brief Function writeJson() writes all stats as one JSON object in one line.
+     *
+     * @param out stream in which stats are written
+     */
+    void writeJson(std::ostream &out)
+    {
+        static const char *stage_names[number_of_stages] = {"generate", "scan", "enumerate", "print", "dijkstra", "fast",
+                                                             "batch", "classes", "fixed", "bound", "incremental",
+                                                             "large", "count"};
+        static const char *counter_names[number_of_counters] = {"instances", "states", "edges", "paths", "dijkstra_states",
+                                                                "dijkstra_edges", "arena_blocks", "arena_bytes",
+                                                                "allocations", "allocated_bytes", "cache_hits",
+                                                                "cache_misses", "cache_evictions", "class_states",
+                                                                "bound_rows", "bound_cuts", "incremental_rows",
+                                                                "large_states", "large_dropped", "count_edges"};
+
+        out << "{\"stages\":{";
+        for (unsigned i = 0; i < number_of_stages; i++)
+            out << (i ? "," : "") << "\"" << stage_names[i] << "\":{\"seconds\":" << m_stage_nanoseconds[i].load() / 1e9
+                << ",\"calls\":" << m_stage_calls[i].load() << "}";
+
+        out << "},\"counters\":{";
+        for (unsigned i = 0; i < number_of_counters; i++)
+            out << (i ? "," : "") << "\"" << counter_names[i] << "\":" << m_counters[i].load();
+
+        unsigned long long requests = 0;
+        for (auto &it : m_latency)
+            requests += it.load(std::memory_order_relaxed);
+        out << "},\"latency\":{\"requests\":" << requests << ",\"p50_us\":" << latency(0.5) << ",\"p99_us\":" << latency(0.99);
+
+        out << "},\"generators\":[";
+        std::lock_guard<std::mutex> guard(m_generators_lock);
+        std::sort(m_generators.begin(), m_generators.end(), [](const GeneratorStats &a, const GeneratorStats &b)
+                  { return a.index != b.index ? a.index < b.index : a.forward > b.forward; });
+        for (std::size_t i = 0; i < m_generators.size(); i++)
+            out << (i ? "," : "") << "{\"direction\":\"" << (m_generators[i].forward ? "forward" : "backward")
+                << "\",\"index\":" << m_generators[i].index << ",\"rows\":" << m_generators[i].rows
+                << ",\"edges\":" << m_generators[i].edges << "}";
+        out << "]}\n";
+    }
+};
+
+/** @brief Function stats() returns stats of the process.*/
+inline solverStats& stats() { return solverStats::instance(); }
+
+
+/**
+ * @brief Class stageTimer measures wall time of one run of stage from constructor to destructor.
+ *
+ * Clock is read only when stats are on.
+ */
+class stageTimer
+{
+    solverStats::Stage m_stage;                               /**< timed stage*/
+    bool m_enabled;                                           /**< stats were on at start*/
+    std::chrono::steady_clock::time_point m_start;            /**< start of the stage*/
+
+public:
+
+    /** @brief Constructor of a class starts timer of stage.*/
+    explicit stageTimer(const solverStats::Stage stage) : m_stage(stage), m_enabled(stats().enabled())
+    {
+        if (m_enabled)
+            m_start = std::chrono::steady_clock::now();
+    }
+
+    /** @brief Destructor of a class adds time of stage to stats.*/
+    ~stageTimer()
+    {
+        if (m_enabled)
+            stats().addTime(m_stage, std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::steady_clock::now() - m_start).count());
+    }
+
+    stageTimer(const stageTimer&) = delete;
+    stageTimer& operator= (const stageTimer&) = delete;
+};
+
+
+/**
+ * @brief Class edgeArena allocates memory for matrices and edges of one generator chain in big blocks.
+ *
+ * Allocation only moves a pointer inside current block, new block is taken from heap when current one is full. Memory
+ * is never released piece by piece, all blocks are released together in destructor, so one arena is made for every
+ * chain of generators and lives as long as the chain lives. Arena that is used for chain after chain is emptied with
+ * reset(), which keeps up to arena_kept_blocks regular blocks for next chain, so small chains take no heap memory.
+ */
+class edgeArena
+{
+    static const std::size_t arena_kept_blocks = 16;     /**< regular blocks kept by reset()*/
+
+    struct Block
+    {
+        char *p_memory;         /**< memory of the block*/
+        std::size_t size;       /**< size of the block in bytes*/
+        std::size_t used;       /**< used bytes from the beginning of the block*/
+    };
+
+    std::vector<Block> m_blocks;     /**< all blocks in use*/
+    std::vector<Block> m_kept;       /**< regular blocks kept by reset() for next allocations*/
+    std::size_t m_block_size;        /**< size of a regular block*/
+    std::size_t m_used_bytes;        /**< bytes given with allocate()*/
+
+public:
+
+    /** @brief Constructor of a class, block_size is size of regular block in bytes.*/
+    explicit edgeArena(const std::size_t block_size = 1 << 20) : m_block_size(block_size), m_used_bytes(0) {}
+
+    /** @brief Destructor of a class releases all blocks.*/
+    ~edgeArena()
+    {
+        reset();
+        for (auto &block : m_kept)
+            delete[] block.p_memory;
+    }
+
+    edgeArena(const edgeArena&) = delete;
+    edgeArena& operator= (const edgeArena&) = delete;
+
+    /**
+     * @brief Function allocate() returns zeroed array of count elements of trivial type T.
+     *
+     * @param count number of elements
+     * @return pointer to first element
+     */
+    template<typename T>
+    T* allocate(const std::size_t count)
+    {
+        const std::size_t bytes = count * sizeof(T);
+        const std::size_t align = alignof(T);
+
+        if (m_blocks.empty() || (m_blocks.back().used + align - 1) / align * align + bytes > m_blocks.back().size)
+        {
+            if (bytes <= m_block_size && !m_kept.empty())
+            {
+                m_blocks.push_back(m_kept.back());
+                m_kept.pop_back();
+            }
+            else
+            {
+                std::size_t size = bytes > m_block_size ? bytes : m_block_size;   /**< big arrays get their own block*/
+                m_blocks.push_back(Block{new char[size], size, 0});
+            }
+        }
+
+        Block &block = m_blocks.back();
+        block.used = (block.used + align - 1) / align * align;
+        T *p_elements = reinterpret_cast<T*>(block.p_memory + block.used);
+        block.used += bytes;
+        m_used_bytes += bytes;
+
+        std::memset(static_cast<void*>(p_elements), 0, bytes);
+        return p_elements;
+    }
+
+    /**
+     * @brief Function reset() makes all memory of the arena free, arrays given before must not be used anymore.
+     *
+     * Big blocks and regular blocks above arena_kept_blocks go back to heap, so arena of long running server does not
+     * keep memory of its biggest request.
+     */
+    void reset()
+    {
+        stats().add(solverStats::counter_arena_blocks, m_blocks.size());
+        stats().add(solverStats::counter_arena_bytes, m_used_bytes);
+        for (auto &block : m_blocks)
+        {
+            if (block.size == m_block_size && m_kept.size() < arena_kept_blocks)
+                m_kept.push_back(Block{block.p_memory, block.size, 0});
+            else
+                delete[] block.p_memory;
+        }
+        m_blocks.clear();
+        m_used_bytes = 0;
+    }
+
+    /** @brief Function blocks() returns number of blocks in use.*/
+    std::size_t blocks() const { return m_blocks.size(); }
+
+    /** @brief Function usedBytes() returns number of bytes given with allocate().*/
+    std::size_t usedBytes() const { return m_used_bytes; }
+};
+
+
+/**
+ * @brief Structure pathEdges contains all edges from rows of one generator to rows of the next generator.
+ *
+ * Edges are stored in compressed sparse rows, edges of row i are from offsets[i] to offsets[i + 1] in arrays successor,
+ * first_person, second_person, other_persons, speed and persons. All arrays are allocated from edgeArena of the generator chain, so
+ * pointers to persons of edges in paths are valid as long as the arena lives.
+ */
+struct pathEdges
+{
+    unsigned *offsets = nullptr;             /**< rows + 1 offsets of first edge of each row*/
+    map_path_row *successor = nullptr;       /**< row of the next generator*/
+    person_index *first_person = nullptr;    /**< first person that travels*/
+    person_index *second_person = nullptr;   /**< second person that travels, no_person when one person returns*/
+    state_word *other_persons = nullptr;     /**< further persons that travel, only when tunnel carries more than two*/
+    unsigned *speed = nullptr;               /**< speed of the edge, lower speed of travelers*/
+    PersonPointers *persons = nullptr;       /**< names and speed of travelers for paths*/
+};
+
+
+/**
+ * @brief Class solutionsGenerator generates all possible solutions from ones and zeros.
+ *
+ * Class defines method for making a matrix of all possible solutions with logical ones and zeros.
+ * Constructor of the class receives the number of logical ones and zeros, addition of this two
+ * parameters give the class number of columns, and number of rows depends on the number of
+ * all possible solutions. The goal is to from a given parameters make a matrix, two dimensional
+ * array with all solutions.
+ * Every row of the matrix is packed in m_row_words words of type state_word, one bit for every person,
+ * and all rows are stored one after another in a single contiguous array.
+ * Matrix and edges are allocated from edgeArena of the generator chain and released with it.
+ */
+class solutionsGenerator
+{
+    unsigned m_matrix_rows;                  /**< number of rows for two-dimensional arrays*/
+    unsigned m_matrix_columns;               /**< number of columns for two-dimensional arrays*/
+    unsigned m_number_of_ones;               /**< number of logical ones defined in class constructor*/
+    unsigned m_row_words;                    /**< number of state_word words in one row*/
+    state_word m_last_word_mask;             /**< mask of used columns in the last word of a row*/
+    state_word *mp_matrix;                   /**< pointer to contiguous array of m_matrix_rows * m_row_words packed rows*/
+    PersonInformation *pointer_of_persons;   /**< pointer to array of structure PersonInformation*/
+    edgeArena *mp_arena;                     /**< arena of the generator chain for matrix and edges*/
+    unsigned m_threads;                      /**< number of threads for scan of rows*/
+
+    /**
+     * @brief Function edgePersons() makes persons and speed of edge with index edge as structure PersonPointers.
+     *
+     * @param edge index of edge in m_edges
+     * @return names and speed of persons on edge, second name is nullptr when one person returns
+     */
+    PersonPointers edgePersons(const unsigned edge) const
+    {
+        PersonPointers persons;
+        const person_index first  = m_edges.first_person[edge];
+        const person_index second = m_edges.second_person[edge];
+
+        persons.first_name = &pointer_of_persons[first].name;
+        persons.speed      = &pointer_of_persons[first].speed;
+        if (second != no_person)
+        {
+            persons.second_name = &pointer_of_persons[second].name;
+            if (pointer_of_persons[second].speed > pointer_of_persons[first].speed)
+                persons.speed = &pointer_of_persons[second].speed;
+        }
+
+        if (m_edges.other_persons != nullptr)                       /**< tunnel carries more than two persons*/
+        {
+            persons.persons       = pointer_of_persons;
+            persons.other_persons = m_edges.other_persons[edge];
+            for (state_word ones = persons.other_persons; ones != 0; ones &= ones - 1)
+                if (pointer_of_persons[__builtin_ctzll(ones)].speed > *persons.speed)
+                    persons.speed = &pointer_of_persons[__builtin_ctzll(ones)].speed;
+        }
+
+        return persons;
+    }
+
+    /**
+     * @brief Function moveRows() records edges from rows first_row to last_row of this matrix to rows of rhs.
+     *
+     * For every row all combinations of number_of_travelers columns with ones are made with forEachCombination(), row of
+     * rhs is this row with travelers moved to the other side, so index of rhs row is found with rowIndex() and no rows
+     * of rhs are compared. Edges of a row are sorted by rhs row, same order as scan of all rhs rows would give.
+     * Every row has exactly row_edges edges, so more threads can record separate ranges of rows into same edge arrays.
+     *
+     * @param rhs parameter, right hand side generator reference
+     * @param number_of_travelers persons that go from this side to other side
+     * @param row_edges number of edges of one row
+     * @param first_row first row of the range
+     * @param last_row end of the range
+     */
+    void moveRows(const solutionsGenerator &rhs, const unsigned number_of_travelers, const unsigned row_edges,
+                  const unsigned first_row, const unsigned last_row)
+    {
+        std::vector<unsigned> columns_of_ones(m_number_of_ones);
+        std::vector<state_word> rhs_row(m_row_words);
+        std::vector<map_path_row> successors(row_edges);
+        std::vector<unsigned> travelers((std::size_t) row_edges * number_of_travelers);
+        std::vector<unsigned> order(row_edges);
+
+        for(unsigned i = first_row; i < last_row; i++)
+        {
+            const state_word *p_row = row(i);
+
+            unsigned found = 0;
+            for (unsigned w = 0; w < m_row_words; w++)
+                for (state_word ones = p_row[w]; ones != 0; ones &= ones - 1)   /**< columns of ones*/
+                    columns_of_ones[found++] = w * state_word_bits + __builtin_ctzll(ones);
+
+            unsigned move = 0;
+            forEachCombination(columns_of_ones.data(), m_number_of_ones, number_of_travelers, [&](const unsigned *p_columns)
+            {
+                for (unsigned w = 0; w < m_row_words; w++)                      /**< other side of the tunnel*/
+                    rhs_row[w] = ~p_row[w] & ((w + 1 == m_row_words) ? m_last_word_mask : ~state_word(0));
+                for (unsigned t = 0; t < number_of_travelers; t++)
+                    rhs_row[p_columns[t] / state_word_bits] |= state_word(1) << (p_columns[t] % state_word_bits);
+
+                successors[move] = rhs.rowIndex(rhs_row.data());
+                std::copy(p_columns, p_columns + number_of_travelers, travelers.begin() + (std::size_t) move * number_of_travelers);
+                order[move] = move;
+                ++move;
+            });
+
+            std::sort(order.begin(), order.end(), [&](unsigned a, unsigned b) { return successors[a] < successors[b]; });
+
+            unsigned edge = m_edges.offsets[i];
+            for (unsigned m : order)
+            {
+                const unsigned *p_columns = travelers.data() + (std::size_t) m * number_of_travelers;
+
+                m_edges.successor[edge]     = successors[m];                    /**< rhs row and persons data*/
+                m_edges.first_person[edge]  = p_columns[0];
+                m_edges.second_person[edge] = number_of_travelers > 1 ? p_columns[1] : no_person;
+                m_edges.speed[edge]         = pointer_of_persons[p_columns[0]].speed;
+                for (unsigned t = 1; t < number_of_travelers; t++)
+                {
+                    m_edges.speed[edge] = std::max(m_edges.speed[edge], pointer_of_persons[p_columns[t]].speed);  /**< put lower speed*/
+                    if (t > 1)
+                        m_edges.other_persons[edge] |= state_word(1) << p_columns[t];
+                }
+                m_edges.persons[edge] = edgePersons(edge);
+                ++edge;
+            }
+        }
+    }
+
+    /**
+     * @brief Function scanRows() records edges from rows first_row to last_row of this matrix by scan of all rhs rows.
+     *
+     * Rows of one state_word are matched against blocks of rhs rows with matchRowsKernel(), so matching rows, persons
+     * that travel and their speed come from one vector kernel and edges are already in order of rhs rows. Edges are
+     * same as from moveRows().
+     *
+     * @param rhs parameter, right hand side generator reference
+     * @param first_row first row of the range
+     * @param last_row end of the range
+     */
+    void scanRows(const solutionsGenerator &rhs, const unsigned first_row, const unsigned last_row)
+    {
+        const matchRowsFunction kernel = matchRowsKernel();
+        std::vector<unsigned> speeds(m_matrix_columns);
+        for (unsigned j = 0; j < m_matrix_columns; j++)
+            speeds[j] = pointer_of_persons[j].speed;
+
+        rowMatches matches;
+        for (unsigned i = first_row; i < last_row; i++)
+        {
+            unsigned edge = m_edges.offsets[i];
+            for (unsigned block = 0; block < rhs.m_matrix_rows; block += rowMatches::block_rows)
+            {
+                kernel(*row(i), rhs.row(block), std::min(rowMatches::block_rows, rhs.m_matrix_rows - block), m_last_word_mask,
+                       speeds.data(), matches);
+
+                for (std::uint64_t bits = matches.bitmap; bits != 0; bits &= bits - 1)
+                {
+                    const unsigned k = __builtin_ctzll(bits);
+                    state_word movers = matches.movers[k];
+
+                    m_edges.successor[edge]    = block + k;                     /**< rhs row and persons data*/
+                    m_edges.speed[edge]        = matches.speed[k];
+                    m_edges.first_person[edge] = __builtin_ctzll(movers);
+                    movers &= movers - 1;
+                    m_edges.second_person[edge] = movers != 0 ? __builtin_ctzll(movers) : no_person;
+                    if (movers != 0 && m_edges.other_persons != nullptr)
+                        m_edges.other_persons[edge] = movers & (movers - 1);
+                    m_edges.persons[edge] = edgePersons(edge);
+                    ++edge;
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Function recordEdges() records edges from every row of this generator to rows of rhs generator.
+     *
+     * Number of persons that travel is difference of ones in both generators and columns, two (or capacity of the
+     * tunnel) for forward->backward, one for backward->forward. Every row has binomial(ones, travelers) edges, so edge
+     * arrays are allocated from arena once and offsets are known before edges are made. With more threads rows are split
+     * in contiguous ranges and every thread records its range at offsets of its rows, so ranges are adjacent without
+     * moving them after the join and edges are same as from one thread.
+     * Rows of one word are scanned with scanRows() when vector scan of rhs rows is cheaper than moves of moveRows().
+     *
+     * @param rhs parameter, right hand side generator reference
+     */
+    void recordEdges(solutionsGenerator &rhs)
+    {
+        mp_next = &rhs;                                            /**< pointer that connect this pointer generator to rhs generator*/
+
+        const unsigned number_of_travelers = m_number_of_ones + rhs.m_number_of_ones - m_matrix_columns;
+        const unsigned row_edges = binomial(m_number_of_ones, number_of_travelers);
+        const std::size_t max_edges = (std::size_t) m_matrix_rows * row_edges;
+        m_edges.offsets       = mp_arena->allocate<unsigned>(m_matrix_rows + 1);
+        m_edges.successor     = mp_arena->allocate<map_path_row>(max_edges);
+        m_edges.first_person  = mp_arena->allocate<person_index>(max_edges);
+        m_edges.second_person = mp_arena->allocate<person_index>(max_edges);
+        m_edges.speed         = mp_arena->allocate<unsigned>(max_edges);
+        m_edges.persons       = mp_arena->allocate<PersonPointers>(max_edges);
+        if (number_of_travelers > 2)
+            m_edges.other_persons = mp_arena->allocate<state_word>(max_edges);
+
+        for (unsigned i = 0; i <= m_matrix_rows; i++)
+            m_edges.offsets[i] = i * row_edges;
+
+        const unsigned scan_rows_per_move = 64;                    /**< rhs rows one vector scan matches in time of one move*/
+        const bool scan = m_row_words == 1 && rhs.m_matrix_rows <= (std::size_t) row_edges * scan_rows_per_move;
+        auto record = [&](const unsigned first_row, const unsigned last_row)
+        {
+            if (scan)
+                scanRows(rhs, first_row, last_row);
+            else
+                moveRows(rhs, number_of_travelers, row_edges, first_row, last_row);
+        };
+
+        const std::size_t min_rows_per_thread = 64;                /**< smaller ranges are not worth a thread*/
+        unsigned number_of_threads = m_threads;
+        if (number_of_threads > m_matrix_rows / min_rows_per_thread)
+            number_of_threads = m_matrix_rows / min_rows_per_thread;
+
+        if (number_of_threads <= 1)
+        {
+            record(0, m_matrix_rows);
+            return;
+        }
+
+        std::vector<std::thread> threads;
+        for (unsigned t = 0; t < number_of_threads; t++)
+        {
+            const unsigned first_row = (unsigned) ((std::size_t) m_matrix_rows * t / number_of_threads);
+            const unsigned last_row  = (unsigned) ((std::size_t) m_matrix_rows * (t + 1) / number_of_threads);
+            threads.emplace_back([&, first_row, last_row]() { record(first_row, last_row); });
+        }
+        for (auto &thread : threads)
+            thread.join();
+    }
+
+public:
+
+    pathEdges m_edges;                                          /**< edges from rows of this generator to rows of mp_next generator*/
+    solutionsGenerator *mp_next;                                /**< pointer to the next solution generator connected via << and >> operators*/
+
+
+    /** @brief Constructor of a class.*/
+    solutionsGenerator()
+    : m_matrix_rows(0), m_matrix_columns(0), m_number_of_ones(0), m_row_words(0), m_last_word_mask(0), mp_matrix(nullptr),
+      pointer_of_persons(nullptr), mp_arena(nullptr), m_threads(1), mp_next(nullptr) {}
+
+
+    /** @brief Function binomial() returns number of ways to choose k columns from n columns.*/
+    static unsigned binomial(const unsigned n, unsigned k)
+    {
+        static const std::vector<unsigned> table = []()           /**< Pascal triangle for less than 64 columns*/
+        {
+            std::vector<unsigned> pascal(state_word_bits * state_word_bits, 0);
+            for (unsigned i = 0; i < state_word_bits; i++)
+            {
+                pascal[i * state_word_bits] = 1;
+                for (unsigned j = 1; j <= i; j++)
+                    pascal[i * state_word_bits + j] = pascal[(i - 1) * state_word_bits + j - 1] + pascal[(i - 1) * state_word_bits + j];
+            }
+            return pascal;
+        }();
+
+        if (k > n)
+            return 0;
+        if (n < state_word_bits)
+            return table[n * state_word_bits + k];
+        if (k > n - k)
+            k = n - k;
+
+        unsigned long long result = 1;
+        for (unsigned i = 1; i <= k; i++)
+            result = result * (n - k + i) / i;
+
+        return (unsigned) result;
+    }
+
+    /** @brief Class operator() from parameters input create possible solution matrix.
+     *
+     * This overloading operator from its parameters create an matrix, two-dimensional array of all combinations zeros
+     * and ones. First row has logical ones in first columns, every next row is next combination of columns with logical
+     * ones in lexicographic order, so matrix has binomial(ones + zeros, ones) rows.
+     *
+     *  @param number_of_ones receives number of logical ones
+     *  @param number_of_zeros receives number of logical zeros
+     *  @param p_of_persons creates a link to the array pointer for structure PersonInformation
+     *  @param arena arena of the generator chain from which matrix and edges are allocated
+     *  @param number_of_threads number of threads for edges of rows with operators >> and <<
+     * */
+    solutionsGenerator& operator() (const unsigned number_of_ones, const unsigned number_of_zeros, PersonInformation *p_of_persons,
+                                    edgeArena &arena, const unsigned number_of_threads = 1)
+    {
+        m_matrix_columns = number_of_ones + number_of_zeros;
+        m_matrix_rows    = binomial(m_matrix_columns, number_of_ones);
+        m_number_of_ones = number_of_ones;
+        m_row_words      = (m_matrix_columns + state_word_bits - 1) / state_word_bits;
+        m_last_word_mask = (m_matrix_columns % state_word_bits) ? (state_word(1) << (m_matrix_columns % state_word_bits)) - 1 : ~state_word(0);
+        pointer_of_persons = p_of_persons;
+        mp_arena         = &arena;
+        m_threads        = number_of_threads;
+
+        mp_matrix = arena.allocate<state_word>((std::size_t) m_matrix_rows * m_row_words);   /**< one contiguous array for all rows*/
+
+        std::vector<unsigned> columns_of_ones(m_number_of_ones);
+        for (unsigned i = 0; i < m_number_of_ones; i++)
+            columns_of_ones[i] = i;                                          /**< first row, ones in first columns*/
+
+        for (unsigned i = 0; i < m_matrix_rows; i++)
+        {
+            state_word *p_row = mp_matrix + (std::size_t) i * m_row_words;
+
+            for (unsigned column : columns_of_ones)
+                p_row[column / state_word_bits] |= state_word(1) << (column % state_word_bits);
+
+            int k = (int) m_number_of_ones - 1;                              /**< next combination of columns with ones*/
+            while (k >= 0 && columns_of_ones[k] == m_matrix_columns - m_number_of_ones + k)
+                k--;
+            if (k < 0)
+                break;
+
+            ++columns_of_ones[k];
+            for (unsigned j = k + 1; j < m_number_of_ones; j++)
+                columns_of_ones[j] = columns_of_ones[j - 1] + 1;
+        }
+
+        return *this;
+    }
+
+    /**
+     * @brief Class operator>> receives as parameter another class of solutionsGenerator for forward backward scan
+     *
+     * This class operator connects two solutionsGenerators, this pointer generator and rhs generator. This is forward
+     * backward operation, rows of both generators match when there are two ones (or as many as tunnel carries) in same
+     * column and no zeros in same column. Small rhs generators are scanned with vector kernel, otherwise matching rows
+     * are not searched, for every row all pairs (combinations) of persons on beginning are moved to the end, and possible
+     * path is then recorded in m_edges, rhs row of the move, users that are traveling and lower speed of them.
+     *
+     * @param rhs parameter, right hand side generator reference
+     */
+    void operator>> (solutionsGenerator &rhs)
+    {
+        recordEdges(rhs);
+    }
+
+    /**
+     * @brief Class operator<< receives as parameter another class of solutionsGenerator for backward forward scan
+     *
+     * This class operator connects two solutionsGenerators, this pointer generator and rhs generator. This is backward
+     * forward operation, rows of both generators match when there is one one in same column and no zeros in same column.
+     * For every row each person on end is returned to the beginning, and possible path is then recorded in m_edges, rhs
+     * row of the move, user that is returning and his speed.
+     *
+     * @param rhs parameter, right hand side generator reference
+     */
+    void operator<< (solutionsGenerator &rhs)
+    {
+        recordEdges(rhs);
+    }
+
+    /**
+     * @brief Function rowIndex() returns index of packed row in this matrix.
+     *
+     * Rows are combinations of columns in lexicographic order, so index is number of rows that have logical zero in
+     * first column where the row has logical one and same columns before it.
+     *
+     * @param p_row pointer to packed row with m_number_of_ones ones
+     * @return index of the row
+     */
+    map_path_row rowIndex(const state_word *p_row) const
+    {
+        map_path_row index = 0;
+        unsigned ones = m_number_of_ones;
+
+        for (unsigned j = 0; j < m_matrix_columns && ones > 0; j++)
+        {
+            if ((p_row[j / state_word_bits] >> (j % state_word_bits)) & 1)
+                --ones;
+            else
+                index += binomial(m_matrix_columns - 1 - j, ones - 1);   /**< rows with one in column j*/
+        }
+
+        return index;
+    }
+
+
+    /** @brief Function row() returns pointer to the first word of packed row with index i.*/
+    const state_word* row(const unsigned i) const { return mp_matrix + (std::size_t) i * m_row_words; }
+
+    /** @brief Function isOne() returns true if row i has logical one in column j.*/
+    bool isOne(const unsigned i, const unsigned j) const { return (row(i)[j / state_word_bits] >> (j % state_word_bits)) & 1; }
+
+    /** @brief Function rows() returning number of rows in matrix.*/
+    unsigned rows() {return m_matrix_rows;};
+
+    /** @brief Function columns() returning number of columns in matrix.*/
+    unsigned columns() {return m_matrix_columns;};
+
+    /** @brief Function rowWords() returning number of state_word words in one row.*/
+    unsigned rowWords() {return m_row_words;};
+
+    /** @brief Function edges() returning number of edges recorded with operators >> and <<.*/
+    unsigned edges() {return m_edges.offsets != nullptr ? m_edges.offsets[m_matrix_rows] : 0;};
+
+};
+
+
+using vector_of_persons = std::vector<PersonPointers*>;
+
+
+/**
+ * @brief Class generatorChain creates generators for each direction and connects them with operators >> and <<.
+ *
+ * Chain owns arena of all generators or uses arena of the caller that is reset when chain ends, so paths from the chain
+ * point to persons of edges that are valid as long as the chain lives. After construction chain is only read, so more threads can enumerate paths from one chain at same time.
+ */
+class generatorChain
+{
+    edgeArena m_own_arena;                          /**< memory of all generators and edges if caller gives no arena*/
+    edgeArena &m_arena;                             /**< arena of all generators and edges*/
+    std::vector<solutionsGenerator> m_forward;      /**< generators of people on beginning before forward->backward*/
+    std::vector<solutionsGenerator> m_backward;     /**< generators of people on end before backward->forward*/
+
+public:
+
+    /**
+     * @brief Constructor of a class creates and scans all generators.
+     *
+     * @param p_of_persons pointer to array of structure PersonInformation
+     * @param number_of_persons number of persons in array, at least two
+     * @param number_of_threads number of threads for edges of rows
+     * @param capacity number of persons that go forward together, at least two, less persons only in the last move
+     * @param p_arena empty arena for generators and edges that is reset in destructor, nullptr - chain has own arena
+     */
+    generatorChain(PersonInformation *p_of_persons, const unsigned number_of_persons, const unsigned number_of_threads = 1,
+                   const unsigned capacity = 2, edgeArena *p_arena = nullptr)
+    : m_arena(p_arena != nullptr ? *p_arena : m_own_arena),
+      m_forward(directions(number_of_persons, capacity)), m_backward(directions(number_of_persons, capacity))
+    {
+        unsigned directions_number = m_forward.size();         /**< half number of directions through tunnel*/
+
+        unsigned f_pattern_one  = number_of_persons;           /**< number of patterns '1' thats decreasing*/
+        unsigned f_pattern_zero = 0;                           /**< number of patterns '0' thats increasing*/
+
+
+        {
+            stageTimer timer(solverStats::stage_generate);
+
+            /**< loop for creating all possible solution matrices for each direction forward and backwards*/
+            for (unsigned i = 0; i < directions_number; i++)
+            {
+                unsigned travelers = std::min(capacity, f_pattern_one);
+
+                m_forward[i](f_pattern_one, f_pattern_zero, p_of_persons, m_arena, number_of_threads);
+                m_backward[i](f_pattern_zero + travelers, f_pattern_one - travelers, p_of_persons, m_arena, number_of_threads);
+                f_pattern_one  -= travelers - 1;
+                f_pattern_zero += travelers - 1;
+            }
+        }
+
+        {
+            stageTimer timer(solverStats::stage_scan);
+
+            /**< connect matrices(generators), and scan them with operators >> and <<  */
+            for (unsigned i = 0; i < directions_number; i++)
+            {
+                m_forward[i] >> m_backward[i];
+
+                if ( (i + 1) < directions_number)
+                    m_backward[i] << m_forward[i + 1];
+            }
+        }
+
+        if (stats().enabled())
+            for (unsigned i = 0; i < directions_number; i++)
+            {
+                stats().addGenerator(true, i, m_forward[i].rows(), m_forward[i].edges());
+                stats().addGenerator(false, i, m_backward[i].rows(), m_backward[i].edges());
+            }
+    }
+
+    /** @brief Destructor of a class gives memory of arena of the caller back for next chain.*/
+    ~generatorChain()
+    {
+        if (&m_arena != &m_own_arena)
+            m_arena.reset();
+    }
+
+    generatorChain(const generatorChain&) = delete;
+    generatorChain& operator= (const generatorChain&) = delete;
+
+    /**
+     * @brief Function directions() returns number of forward->backward moves of every path.
+     *
+     * Every round capacity persons go forward and one returns, last move takes all remaining persons.
+     *
+     * @param number_of_persons number of persons, at least two
+     * @param capacity number of persons that go forward together, at least two
+     * @return number of forward generators of the chain
+     */
+    static unsigned directions(const unsigned number_of_persons, const unsigned capacity)
+    {
+        unsigned directions_number = 1;
+        for (unsigned on_beginning = number_of_persons; on_beginning > capacity; on_beginning -= capacity - 1)
+            ++directions_number;
+        return directions_number;
+    }
+
+    /** @brief Function start() returns first generator of the chain, all persons on beginning.*/
+    solutionsGenerator* start() { return &m_forward[0]; }
+
+    /** @brief Function arena() returns arena of the chain.*/
+    const edgeArena& arena() const { return m_arena; }
+};
+
+
+/**
+ * @brief Class pathSource is interface of everything that gives complete paths one by one.
+ */
+class pathSource
+{
+public:
+
+    virtual ~pathSource() = default;
+
+    /**
+     * @brief Function next() finds next complete path.
+     *
+     * @return pointer to the path that is valid until next call, nullptr when there are no more paths
+     */
+    virtual const vector_of_persons* next() = 0;
+
+    /** @brief Function speed() returns total speed of the path given with last next().*/
+    virtual unsigned long long speed() const = 0;
+};
+
+
+/**
+ * @brief Class pathEnumerator gives paths from generator chain one by one.
+ *
+ * Enumerator walks edges of generators in same order as recursion would do, but with its own stack, so only one path
+ * and one stack frame for every generator is in memory. Every enumerator has its own state and only reads generators,
+ * so more enumerators can run on same chain from more threads. Range of rows of start generator can be given, so paths
+ * can be split between enumerators.
+ */
+class pathEnumerator : public pathSource
+{
+    struct Frame
+    {
+        solutionsGenerator *p_generator;   /**< generator whose edges are walked*/
+        unsigned edge;                     /**< next edge of the row*/
+        unsigned end;                      /**< end of edges of the row*/
+    };
+
+    solutionsGenerator *mp_start;          /**< first generator of the chain*/
+    unsigned m_next_row;                   /**< next row of start generator*/
+    unsigned m_last_row;                   /**< end of rows of start generator*/
+    std::vector<Frame> m_frames;           /**< stack of walked rows*/
+    vector_of_persons m_path;              /**< current path*/
+    unsigned long long m_speed;            /**< total speed of current path*/
+    unsigned long long m_paths;            /**< number of given paths*/
+
+    /** @brief Function pushRow() puts edges of row of generator on stack.*/
+    void pushRow(solutionsGenerator *p_generator, const map_path_row row)
+    {
+        m_frames.push_back(Frame{p_generator, p_generator->m_edges.offsets[row], p_generator->m_edges.offsets[row + 1]});
+    }
+
+public:
+
+    /**
+     * @brief Constructor of a class.
+     *
+     * @param start first generator of the chain
+     * @param first_row first row of start generator from which paths are given
+     * @param last_row end of rows of start generator
+     */
+    pathEnumerator(solutionsGenerator *start, const unsigned first_row, const unsigned last_row)
+    : mp_start(start), m_next_row(first_row), m_last_row(last_row), m_speed(0), m_paths(0) {}
+
+    /** @brief Constructor of a class for paths from all rows of start generator.*/
+    explicit pathEnumerator(solutionsGenerator *start) : pathEnumerator(start, 0, start->rows()) {}
+
+    /**
+     * @brief Constructor of a class for paths that start with edges first_edge to last_edge of one row of start generator.
+     *
+     * @param start first generator of the chain
+     * @param row row of start generator
+     * @param first_edge first edge of the row
+     * @param last_edge end of edges of the row
+     */
+    pathEnumerator(solutionsGenerator *start, const unsigned row, const unsigned first_edge, const unsigned last_edge)
+    : mp_start(start), m_next_row(row + 1), m_last_row(row + 1), m_speed(0), m_paths(0)
+    {
+        m_frames.push_back(Frame{start, first_edge, last_edge});
+    }
+
+    /** @brief Destructor of a class adds number of given paths to stats.*/
+    ~pathEnumerator() { stats().add(solverStats::counter_paths, m_paths); }
+
+    const vector_of_persons* next() override
+    {
+        for (;;)
+        {
+            if (m_frames.empty())
+            {
+                if (m_next_row >= m_last_row || mp_start->m_edges.offsets == nullptr)
+                    return nullptr;
+                pushRow(mp_start, m_next_row++);
+                continue;
+            }
+
+            Frame &top = m_frames.back();
+            if (top.edge == top.end)
+            {
+                m_frames.pop_back();
+                continue;
+            }
+
+            const unsigned edge = top.edge++;
+            solutionsGenerator *p_generator = top.p_generator;
+            m_path.resize(m_frames.size() - 1);
+            m_path.push_back(&p_generator->m_edges.persons[edge]);   /**< push back person(s) name and speed*/
+
+            solutionsGenerator *p_next = p_generator->mp_next;
+            if (p_next == nullptr || p_next->m_edges.offsets == nullptr)   /**< last generator, path is complete*/
+            {
+                m_speed = 0;
+                for (auto &it : m_path)
+                    m_speed += *it->speed;
+                ++m_paths;
+                return &m_path;
+            }
+
+            pushRow(p_next, p_generator->m_edges.successor[edge]);
+        }
+    }
+
+    unsigned long long speed() const override { return m_speed; }
+};
+
+
+/**
+ * @brief Class pathBuffer gives paths one by one from vector of paths that are already sorted.
+ */
+class pathBuffer : public pathSource
+{
+    const std::vector<vector_of_persons> &m_paths;   /**< all paths*/
+    std::size_t m_next_path;                         /**< index of next path*/
+    unsigned long long m_speed;                      /**< total speed of current path*/
+
+public:
+
+    /** @brief Constructor of a class, paths must live as long as buffer.*/
+    explicit pathBuffer(const std::vector<vector_of_persons> &paths) : m_paths(paths), m_next_path(0), m_speed(0) {}
+
+    const vector_of_persons* next() override
+    {
+        if (m_next_path >= m_paths.size())
+            return nullptr;
+
+        const vector_of_persons &path = m_paths[m_next_path++];
+        m_speed = 0;
+        for (auto &it : path)
+            m_speed += *it->speed;
+        return &path;
+    }
+
+    unsigned long long speed() const override { return m_speed; }
+};
+
+
+/**
+ * @brief pathSortingFunction() function sort all possibilities from generated matrices and from theirs edges
+ *
+ * This function sort in pth_vector all possible solutions that starts from row i of solutionsGenerator pointer start.
+ * This pointer is first of many pointers that goes from each one generated matrices ie. generators, the information
+ * from each generator is connected and put in vector for easier looping through iterator. Paths are taken from
+ * pathEnumerator, so function has no static state and can be called from more threads.
+ *
+ * @param i row of start generator
+ * @param start is a pointer that points to solutionsGenerator generator
+ * @param pth_vector is a vector of vectors reference in which will be recorded all possible solutions
+ *
+ * @return no return
+ * */
+inline void pathSortingFunction(const unsigned i, solutionsGenerator *start, std::vector<vector_of_persons> &pth_vector)
+{
+    pathEnumerator paths(start, i, i + 1);
+
+    while (const vector_of_persons *p_path = paths.next())
+        pth_vector.push_back(*p_path);            /**< on end of path push back persons path data */
+}
+
+/**
+ * @brief minimumPath() function returns copy of the quickest path, first one if more paths have same speed
+ *
+ * @param paths source of all path solutions
+ * @return moves of the quickest path, empty if there are no paths
+ */
+inline std::vector<PersonPointers> minimumPath(pathSource &paths)
+{
+    stageTimer timer(solverStats::stage_enumerate);
+    std::vector<PersonPointers> min_path;
+    unsigned long long minimal_speed = 0;
+
+    while (const vector_of_persons *p_path = paths.next())
+    {
+        if (minimal_speed == 0 || minimal_speed > paths.speed())
+        {
+            minimal_speed = paths.speed();
+            min_path.clear();
+            for (auto &it : *p_path)
+                min_path.push_back(*it);
+        }
+    }
+
+    return min_path;
+}
+
+/**@brief Structure which contains one path and its total speed for ranking of paths*/
+struct RankedPath
+{
+    unsigned long long speed;     /**< total speed of the path*/
+    std::size_t task;             /**< edge of start generator of parallel enumeration, 0 for one enumerator*/
+    std::size_t order;            /**< order in which path is enumerated in task, first one wins on same speed*/
+    vector_of_persons path;       /**< moves of the path*/
+
+    bool operator< (const RankedPath &rhs) const
+    {
+        if (speed != rhs.speed)
+            return speed < rhs.speed;
+        return task != rhs.task ? task < rhs.task : order < rhs.order;
+    }
+};
+
+/**
+ * @brief cheapestPaths() function returns number_of_paths quickest paths, sorted from the quickest
+ *
+ * Paths are taken one by one from enumerator and only number_of_paths best of them are kept in max-heap, so memory
+ * does not depend on number of all paths.
+ *
+ * @param paths source of all path solutions
+ * @param number_of_paths number of paths to keep
+ * @return quickest paths with their speeds
+ */
+inline std::vector<RankedPath> cheapestPaths(pathSource &paths, const std::size_t number_of_paths)
+{
+    stageTimer timer(solverStats::stage_enumerate);
+    std::priority_queue<RankedPath> heap;        /**< slowest of kept paths on top*/
+    std::size_t order = 0;
+
+    if (number_of_paths > 0)
+        while (const vector_of_persons *p_path = paths.next())
+        {
+            RankedPath ranked{paths.speed(), 0, order++, vector_of_persons()};
+            if (heap.size() == number_of_paths && !(ranked < heap.top()))
+                continue;
+
+            ranked.path = *p_path;
+            heap.push(std::move(ranked));
+            if (heap.size() > number_of_paths)
+                heap.pop();
+        }
+
+    std::vector<RankedPath> ranked_paths;
+    for (; !heap.empty(); heap.pop())
+        ranked_paths.push_back(heap.top());
+    std::reverse(ranked_paths.begin(), ranked_paths.end());
+
+    return ranked_paths;
+}
+
+/**
+ * @brief parallelTasks() function walks subtrees of paths that start with edges of start generator on more threads
+ *
+ * Every edge of start generator is one task, subtree of paths that start with this edge. Tasks are split between
+ * workers in contiguous ranges, every worker takes tasks from front of its own queue and when its queue is empty steals
+ * tasks from back of queues of other workers. For every task visit(w, task, paths) is called on worker w with
+ * pathEnumerator of the subtree, tasks are numbered in order of paths of one pathEnumerator.
+ *
+ * @param start first generator of the chain
+ * @param number_of_threads number of worker threads
+ * @param visit function that takes paths of one task
+ * @return number of tasks
+ */
+template<typename Visit>
+inline std::size_t parallelTasks(solutionsGenerator *start, unsigned number_of_threads, Visit visit)
+{
+    struct Task
+    {
+        unsigned row;                                   /**< row of start generator*/
+        unsigned edge;                                  /**< edge of the row*/
+    };
+    struct WorkerQueue
+    {
+        std::mutex lock;                                /**< lock for owner and thieves*/
+        std::deque<std::size_t> tasks;                  /**< indexes of tasks*/
+    };
+
+    std::vector<Task> tasks;
+    if (start->m_edges.offsets != nullptr)
+        for (unsigned i = 0; i < start->rows(); i++)
+            for (unsigned edge = start->m_edges.offsets[i]; edge < start->m_edges.offsets[i + 1]; edge++)
+                tasks.push_back(Task{i, edge});
+
+    if (number_of_threads == 0)
+        number_of_threads = 1;
+
+    std::vector<WorkerQueue> queues(number_of_threads);
+    for (unsigned w = 0; w < number_of_threads; w++)
+        for (std::size_t t = tasks.size() * w / number_of_threads; t < tasks.size() * (w + 1) / number_of_threads; t++)
+            queues[w].tasks.push_back(t);
+
+    auto take_task = [&](unsigned w, std::size_t &task)
+    {
+        for (unsigned i = 0; i < number_of_threads; i++)
+        {
+            WorkerQueue &queue = queues[(w + i) % number_of_threads];
+            std::lock_guard<std::mutex> guard(queue.lock);
+            if (queue.tasks.empty())
+                continue;
+            if (i == 0)                                 /**< own queue from front*/
+            {
+                task = queue.tasks.front();
+                queue.tasks.pop_front();
+            }
+            else                                        /**< steal from back*/
+            {
+                task = queue.tasks.back();
+                queue.tasks.pop_back();
+            }
+            return true;
+        }
+        return false;
+    };
+
+    auto worker = [&](unsigned w)
+    {
+        for (std::size_t task; take_task(w, task); )
+        {
+            pathEnumerator paths(start, tasks[task].row, tasks[task].edge, tasks[task].edge + 1);
+            visit(w, task, paths);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned w = 1; w < number_of_threads; w++)
+        threads.emplace_back(worker, w);
+    worker(0);
+    for (auto &thread : threads)
+        thread.join();
+
+    return tasks.size();
+}
+
+/**
+ * @brief parallelCheapest() function returns number_of_paths quickest paths of generator chain found on more threads
+ *
+ * Tasks of parallelTasks() are walked by workers and every worker keeps only number_of_paths best paths of its tasks
+ * in its own max-heap, so memory does not depend on number of all paths. Paths are ranked by task and order in task,
+ * so on same speed wins same path as from cheapestPaths() over one pathEnumerator, heaps are merged at the end.
+ *
+ * @param start first generator of the chain
+ * @param number_of_threads number of worker threads
+ * @param number_of_paths number of paths to keep
+ * @return quickest paths with their speeds, sorted from the quickest
+ */
+inline std::vector<RankedPath> parallelCheapest(solutionsGenerator *start, unsigned number_of_threads,
+                                                const std::size_t number_of_paths)
+{
+    stageTimer timer(solverStats::stage_enumerate);
+    std::vector<std::priority_queue<RankedPath>> heaps(std::max(number_of_threads, 1u));   /**< heap of every worker*/
+
+    if (number_of_paths > 0)
+        parallelTasks(start, number_of_threads, [&](unsigned w, std::size_t task, pathEnumerator &paths)
+        {
+            std::priority_queue<RankedPath> &heap = heaps[w];
+            std::size_t order = 0;
+            while (const vector_of_persons *p_path = paths.next())
+            {
+                RankedPath ranked{paths.speed(), task, order++, vector_of_persons()};
+                if (heap.size() == number_of_paths && !(ranked < heap.top()))
+                    continue;
+
+                ranked.path = *p_path;
+                heap.push(std::move(ranked));
+                if (heap.size() > number_of_paths)
+                    heap.pop();
+            }
+        });
+
+    std::vector<RankedPath> ranked_paths;
+    for (auto &heap : heaps)
+        for (; !heap.empty(); heap.pop())
+            ranked_paths.push_back(heap.top());
+    std::sort(ranked_paths.begin(), ranked_paths.end());
+    if (ranked_paths.size() > number_of_paths)
+        ranked_paths.resize(number_of_paths);
+
+    return ranked_paths;
+}
+
+/**
+ * @brief parallelMinimum() function returns copy of the quickest path found on more threads, first one if more paths
+ * have same speed
+ *
+ * @param start first generator of the chain
+ * @param number_of_threads number of worker threads
+ * @return moves of the quickest path, empty if there are no paths
+ */
+inline std::vector<PersonPointers> parallelMinimum(solutionsGenerator *start, const unsigned number_of_threads)
+{
+    std::vector<PersonPointers> min_path;
+    for (auto &ranked : parallelCheapest(start, number_of_threads, 1))
+        for (auto &it : ranked.path)
+            min_path.push_back(*it);
+    return min_path;
+}
+
+/**
+ * @brief Class parallelEnumerator gives paths of generator chain that workers enumerate on more threads, in order of
+ * one pathEnumerator.
+ *
+ * Every edge of start generator is one task, workers take tasks in order and record paths of a task in their own
+ * buffers of chunk_paths paths. Next() takes buffers of the task that is read now as they are finished and releases
+ * them after their paths, so printing and dump start before enumeration ends. Worker of later task waits while
+ * m_max_chunks buffers wait for reading, worker of the task that is read waits only for its own current_chunks buffers,
+ * so memory is bounded and buffers of later tasks cannot block reading. Workers stop when enumerator is destroyed.
+ */
+class parallelEnumerator : public pathSource
+{
+    static const std::size_t chunk_paths = 4096;      /**< paths in one buffer*/
+    static const std::size_t current_chunks = 2;      /**< most buffers of the task that is read*/
+
+    struct Task
+    {
+        unsigned row;                                    /**< row of start generator*/
+        unsigned edge;                                   /**< edge of the row*/
+        std::deque<std::vector<vector_of_persons>> chunks;   /**< finished buffers that are not read*/
+        bool done;                                       /**< all paths of the task are in buffers*/
+    };
+
+    solutionsGenerator *mp_start;                     /**< first generator of the chain*/
+    std::vector<Task> m_tasks;                        /**< tasks in order of paths*/
+    std::mutex m_lock;                                /**< lock for tasks, counters and m_stopping*/
+    std::condition_variable m_ready;                  /**< wakes reader when buffer or task is finished*/
+    std::condition_variable m_space;                  /**< wakes workers when buffer is read*/
+    std::size_t m_next_task;                          /**< next task for workers*/
+    std::size_t m_current;                            /**< task that is read*/
+    std::size_t m_waiting;                            /**< finished buffers that are not read*/
+    std::size_t m_max_chunks;                         /**< most buffers that wait for reading*/
+    bool m_stopping;                                  /**< workers end*/
+    std::vector<vector_of_persons> m_chunk;           /**< buffer that is read*/
+    std::size_t m_next_path;                          /**< next path of buffer that is read*/
+    unsigned long long m_speed;                       /**< total speed of current path*/
+    std::vector<std::thread> m_workers;               /**< worker threads*/
+
+    /** @brief Function publish() gives buffer of task to reader, returns false if enumerator is destroyed.*/
+    bool publish(const std::size_t task, std::vector<vector_of_persons> &chunk, const bool done)
+    {
+        std::unique_lock<std::mutex> guard(m_lock);
+        if (!chunk.empty())
+        {
+            m_space.wait(guard, [&]() { return m_stopping || (task == m_current ? m_tasks[task].chunks.size() < current_chunks
+                                                                                 : m_waiting < m_max_chunks); });
+            m_tasks[task].chunks.push_back(std::move(chunk));
+            ++m_waiting;
+        }
+        m_tasks[task].done = done;
+        chunk = std::vector<vector_of_persons>();
+        m_ready.notify_one();
+        return !m_stopping;
+    }
+
+    /** @brief Function work() is loop of worker thread, it takes tasks in order until all are taken.*/
+    void work()
+    {
+        for (;;)
+        {
+            std::size_t task;
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+                if (m_stopping || m_next_task == m_tasks.size())
+                    return;
+                task = m_next_task++;
+            }
+
+            pathEnumerator paths(mp_start, m_tasks[task].row, m_tasks[task].edge, m_tasks[task].edge + 1);
+            std::vector<vector_of_persons> chunk;
+            chunk.reserve(chunk_paths);
+            while (const vector_of_persons *p_path = paths.next())
+            {
+                chunk.push_back(*p_path);
+                if (chunk.size() == chunk_paths && !publish(task, chunk, false))
+                    return;
+            }
+            if (!publish(task, chunk, true))
+                return;
+        }
+    }
+
+public:
+
+    /**
+     * @brief Constructor of a class starts worker threads.
+     *
+     * @param start first generator of the chain, chain must live as long as enumerator
+     * @param number_of_threads number of worker threads
+     */
+    parallelEnumerator(solutionsGenerator *start, unsigned number_of_threads)
+    : mp_start(start), m_next_task(0), m_current(0), m_waiting(0), m_stopping(false), m_next_path(0), m_speed(0)
+    {
+        if (start->m_edges.offsets != nullptr)
+            for (unsigned i = 0; i < start->rows(); i++)
+                for (unsigned edge = start->m_edges.offsets[i]; edge < start->m_edges.offsets[i + 1]; edge++)
+                    m_tasks.push_back(Task{i, edge, {}, false});
+
+        if (number_of_threads == 0)
+            number_of_threads = 1;
+        m_max_chunks = 4 * number_of_threads;
+        for (unsigned w = 0; w < number_of_threads; w++)
+            m_workers.emplace_back([this]() { work(); });
+    }
+
+    /** @brief Destructor of a class stops worker threads.*/
+    ~parallelEnumerator()
+    {
+        {
+            std::lock_guard<std::mutex> guard(m_lock);
+            m_stopping = true;
+        }
+        m_space.notify_all();
+        for (auto &worker : m_workers)
+            worker.join();
+    }
+
+    parallelEnumerator(const parallelEnumerator&) = delete;
+    parallelEnumerator& operator= (const parallelEnumerator&) = delete;
+
+    const vector_of_persons* next() override
+    {
+        while (m_next_path == m_chunk.size())
+        {
+            std::unique_lock<std::mutex> guard(m_lock);
+            m_ready.wait(guard, [this]()
+                         { return m_current == m_tasks.size() || !m_tasks[m_current].chunks.empty() || m_tasks[m_current].done; });
+            if (m_current == m_tasks.size())
+                return nullptr;
+
+            Task &task = m_tasks[m_current];
+            if (!task.chunks.empty())
+            {
+                m_chunk = std::move(task.chunks.front());
+                task.chunks.pop_front();
+                --m_waiting;
+            }
+            else                                          /**< task is done and read*/
+            {
+                m_chunk.clear();
+                ++m_current;
+            }
+            m_next_path = 0;
+            m_space.notify_all();
+        }
+
+        const vector_of_persons &path = m_chunk[m_next_path++];
+        m_speed = 0;
+        for (auto &it : path)
+            m_speed += *it->speed;
+        return &path;
+    }
+
+    unsigned long long speed() const override { return m_speed; }
+};
+
+/**
+ * @brief Class bigCounter is unsigned integer of any size for numbers of paths.
+ *
+ * Number of paths grows faster than factorial of number of persons, so it is kept in 64-bit words from the lowest one
+ * and only addition and decimal text are needed.
+ */
+class bigCounter
+{
+    std::vector<std::uint64_t> m_words;        /**< words from the lowest, highest word is not zero*/
+
+public:
+
+    /** @brief Constructor of a class with value, zero by default.*/
+    explicit bigCounter(const std::uint64_t value = 0)
+    {
+        if (value != 0)
+            m_words.push_back(value);
+    }
+
+    /** @brief Operator += adds rhs to this number.*/
+    bigCounter& operator+= (const bigCounter &rhs)
+    {
+        if (m_words.size() < rhs.m_words.size())
+            m_words.resize(rhs.m_words.size(), 0);
+
+        std::uint64_t carry = 0;
+        for (std::size_t i = 0; i < m_words.size() && (carry != 0 || i < rhs.m_words.size()); i++)
+        {
+            const std::uint64_t add = i < rhs.m_words.size() ? rhs.m_words[i] : 0;
+            const std::uint64_t sum = m_words[i] + add;
+            m_words[i] = sum + carry;
+            carry = (sum < add) || (m_words[i] < sum);
+        }
+        if (carry != 0)
+            m_words.push_back(carry);
+        return *this;
+    }
+
+    bool operator== (const bigCounter &rhs) const { return m_words == rhs.m_words; }
+    bool operator!= (const bigCounter &rhs) const { return m_words != rhs.m_words; }
+
+    /** @brief Function isZero() returns true if number is zero.*/
+    bool isZero() const { return m_words.empty(); }
+
+    /** @brief Function toString() returns decimal text of the number.*/
+    std::string toString() const
+    {
+        const std::uint64_t base = 1000000000;   /**< 10^9, 9 digits in one part, remainder and 32-bit limb fit in 64 bits*/
+        std::vector<std::uint64_t> words(m_words), parts;
+        while (!words.empty())
+        {
+            std::uint64_t remainder = 0;
+            for (std::size_t i = words.size(); i-- > 0; )         /**< high and low 32-bit limbs of every word*/
+            {
+                const std::uint64_t high = (remainder << 32) | (words[i] >> 32);
+                remainder = high % base;
+                const std::uint64_t low = (remainder << 32) | (words[i] & 0xFFFFFFFF);
+                remainder = low % base;
+                words[i]  = ((high / base) << 32) | (low / base);
+            }
+            parts.push_back(remainder);
+            while (!words.empty() && words.back() == 0)
+                words.pop_back();
+        }
+
+        if (parts.empty())
+            return "0";
+
+        std::string text = std::to_string(parts.back());
+        for (std::size_t i = parts.size() - 1; i-- > 0; )
+        {
+            std::string part = std::to_string(parts[i]);
+            text.append(9 - part.size(), '0');
+            text += part;
+        }
+        return text;
+    }
+};
+
+/**@brief Structure which contains number of paths and number of the quickest paths*/
+struct PathCounts
+{
+    bigCounter paths;               /**< number of all paths*/
+    unsigned long long speed = 0;   /**< total speed of the quickest path, 0 if there are no paths*/
+    bigCounter minimal_paths;       /**< number of paths with speed of the quickest path*/
+
+    /** @brief Function add() counts paths of tail that start with edge of speed edge_speed.*/
+    void add(const PathCounts &tail, const unsigned edge_speed)
+    {
+        if (tail.paths.isZero())
+            return;
+
+        paths += tail.paths;
+        const unsigned long long path_speed = tail.speed + edge_speed;
+        if (minimal_paths.isZero() || path_speed < speed)
+        {
+            speed = path_speed;
+            minimal_paths = tail.minimal_paths;
+        }
+        else if (path_speed == speed)
+            minimal_paths += tail.minimal_paths;
+    }
+};
+
+/**
+ * @brief countPaths() function counts all paths of generator chain and the quickest of them without enumeration
+ *
+ * Generators are walked from the last one to start, for every row number of paths to the end, speed of the quickest
+ * of them and number of paths with that speed are made from rows of the next generator that its edges lead to. So time
+ * is proportional to number of edges times size of counters, not to number of paths. Counts are same as number of
+ * paths that pathEnumerator gives from all rows of start generator.
+ *
+ * @param start first generator of the chain
+ * @return number of paths, speed of the quickest path and number of paths with that speed
+ */
+inline PathCounts countPaths(solutionsGenerator *start)
+{
+    stageTimer timer(solverStats::stage_count);
+    std::vector<solutionsGenerator*> generators;            /**< generators with edges, in order of the chain*/
+    for (solutionsGenerator *p_generator = start; p_generator != nullptr && p_generator->m_edges.offsets != nullptr;
+         p_generator = p_generator->mp_next)
+        generators.push_back(p_generator);
+
+    const PathCounts end{bigCounter(1), 0, bigCounter(1)};  /**< empty tail after the last generator*/
+    std::vector<PathCounts> rows, next_rows;
+    unsigned long long edges = 0;
+
+    for (std::size_t i = generators.size(); i-- > 0; )
+    {
+        solutionsGenerator *p_generator = generators[i];
+        const pathEdges &path_edges = p_generator->m_edges;
+        const bool last = i + 1 == generators.size();
+
+        rows.assign(p_generator->rows(), PathCounts());
+        for (unsigned row = 0; row < p_generator->rows(); row++)
+            for (unsigned edge = path_edges.offsets[row]; edge < path_edges.offsets[row + 1]; edge++)
+                rows[row].add(last ? end : next_rows[path_edges.successor[edge]], path_edges.speed[edge]);
+
+        edges += p_generator->edges();
+        std::swap(rows, next_rows);
+    }
+    stats().add(solverStats::counter_count_edges, edges);
+
+    PathCounts counts;                                      /**< paths from all rows of start generator*/
+    for (auto &row : next_rows)
+        counts.add(row, 0);
+    return counts;
+}
+
+/**@brief Formats of schedules written by batch and server*/
+enum OutputFormat
+{
+    format_text,        /**< "->a-b 2 <-a 1 ... ** minimal speed: X **", same as on screen*/
+    format_csv,         /**< "X,->a-b 2 <-a 1 ...", total speed and moves, "error,message" for errors*/
+    format_ndjson       /**< one JSON object in line with speed and moves, {"error":"message"} for errors*/
+};
+
+/** @brief Function appendNumber() appends decimal number to buffer without stream.*/
+inline void appendNumber(std::string &buffer, const unsigned long long value)
+{
+    char digits[24];
+    buffer.append(digits, std::to_chars(digits, digits + sizeof(digits), value).ptr);
+}
+
+/**
+ * @brief Function appendQuoted() appends name or message to buffer, quoted for csv and ndjson formats.
+ *
+ * For csv text is quoted only when it has comma, quote or new line, for ndjson it is always JSON string.
+ */
+inline void appendQuoted(std::string &buffer, const std::string &text, const OutputFormat format)
+{
+    if (format == format_text || (format == format_csv && text.find_first_of(",\"\r\n") == std::string::npos))
+    {
+        buffer += text;
+        return;
+    }
+
+    buffer += '"';
+    for (char character : text)
+    {
+        if (character == '"')
+            buffer += format == format_csv ? "\"\"" : "\\\"";
+        else if (format == format_ndjson && character == '\\')
+            buffer += "\\\\";
+        else if (format == format_ndjson && (unsigned char) character < 0x20)
+        {
+            const char *hex = "0123456789abcdef";
+            buffer += "\\u00";
+            buffer += hex[(unsigned char) character >> 4];
+            buffer += hex[character & 15];
+        }
+        else
+            buffer += character;
+    }
+    buffer += '"';
+}
+
+/**
+ * @brief appendMove() function appends one move of a path to buffer, persons that are going forward "->" or returning "<-"
+ *
+ * @param buffer text to which move is appended
+ * @param move contains person(s) and speed of one move
+ * @return speed of the move
+ */
+inline unsigned appendMove(std::string &buffer, const PersonPointers &move)
+{
+    buffer += move.second_name != nullptr ? "->" : "<-";
+
+    buffer += *move.first_name;
+    if(move.second_name != nullptr)
+    {
+        buffer += '-';
+        buffer += *move.second_name;
+    }
+    for (std::uint64_t ones = move.other_persons; ones != 0; ones &= ones - 1)
+    {
+        buffer += '-';
+        buffer += move.persons[__builtin_ctzll(ones)].name;
+    }
+    buffer += ' ';
+    appendNumber(buffer, *move.speed);
+    buffer += ' ';
+
+    return *move.speed;
+}
+
+/**
+ * @brief printMove() function prints one move of a path, persons that are going forward "->" or returning "<-"
+ *
+ * @param move contains person(s) and speed of one move
+ * @param out stream in which move is printed, screen by default
+ * @return speed of the move
+ */
+inline unsigned printMove(const PersonPointers &move, std::ostream &out = std::cout)
+{
+    std::string buffer;
+    unsigned speed = appendMove(buffer, move);
+    out << buffer;
+    return speed;
+}
+
+/**
+ * @brief printMinimum() function prints on screen all paths and then minimum needed path
+ *
+ * Paths are printed as enumerator gives them, only the quickest one is kept in memory. Lines of paths are collected in
+ * one buffer that is written to the screen in blocks of 64 KiB.
+ *
+ * @param paths source of all path solutions
+ * @return no return
+ */
+inline void printMinimum(pathSource &paths)
+{
+    stageTimer timer(solverStats::stage_print);
+    const std::size_t block_size = 1 << 16;
+    unsigned long long minimal_speed = 0;
+    vector_of_persons min_vector_of_paths;
+    std::string buffer;
+    buffer.reserve(2 * block_size);
+
+
+    while (const vector_of_persons *p_path = paths.next())   /**< paths iteration*/
+    {
+        unsigned long long total_speed = 0;
+
+        for (auto &itb : *p_path)                 /**< path iteration*/
+            total_speed += appendMove(buffer, *itb);
+
+        if(minimal_speed == 0)
+        {
+            minimal_speed = total_speed;
+            min_vector_of_paths = *p_path;
+        }
+        else if(minimal_speed > total_speed)
+        {
+            minimal_speed = total_speed;
+            min_vector_of_paths = *p_path;
+        }
+        buffer += "** total speed: ";
+        appendNumber(buffer, total_speed);
+        buffer += " **\n";
+
+        if (buffer.size() >= block_size)
+        {
+            std::cout.write(buffer.data(), buffer.size());
+            buffer.clear();
+        }
+    }
+
+    unsigned long long min_speed = 0;
+
+    buffer += "\n***minimal speed ***\n";
+    for (auto &it : min_vector_of_paths)
+        min_speed += appendMove(buffer, *it);
+
+    buffer += "** minimal speed: ";
+    appendNumber(buffer, min_speed);
+    buffer += " **\n";
+    std::cout.write(buffer.data(), buffer.size());
+}
+
+/**
+ * @brief printRanked() function prints on screen ranked paths with their numbers
+ *
+ * @param ranked_paths paths sorted from the quickest
+ * @return no return
+ */
+inline void printRanked(const std::vector<RankedPath> &ranked_paths)
+{
+    std::string buffer;
+
+    for (std::size_t i = 0; i < ranked_paths.size(); i++)
+    {
+        buffer += '#';
+        appendNumber(buffer, i + 1);
+        buffer += ' ';
+        for (auto &it : ranked_paths[i].path)
+            appendMove(buffer, *it);
+        buffer += "** total speed: ";
+        appendNumber(buffer, ranked_paths[i].speed);
+        buffer += " **\n";
+    }
+    std::cout.write(buffer.data(), buffer.size());
+}
+
+/**
+ * @brief printCheapest() function prints on screen number_of_paths quickest paths
+ *
+ * @param paths source of all path solutions
+ * @param number_of_paths number of paths to print
+ * @return no return
+ */
+inline void printCheapest(pathSource &paths, const std::size_t number_of_paths)
+{
+    printRanked(cheapestPaths(paths, number_of_paths));
+}
+
+/**
+ * @brief appendSchedule() function appends moves of a schedule and its total speed in one line to buffer
+ *
+ * @param buffer text to which schedule is appended
+ * @param schedule contains moves of the minimal path
+ * @param format text, csv or ndjson
+ * @return no return
+ */
+inline void appendSchedule(std::string &buffer, const std::vector<PersonPointers> &schedule, const OutputFormat format = format_text)
+{
+    unsigned long long min_speed = 0;
+    for (auto &it : schedule)
+        min_speed += *it.speed;
+
+    if (format == format_ndjson)
+    {
+        buffer += "{\"speed\":";
+        appendNumber(buffer, min_speed);
+        buffer += ",\"moves\":[";
+        for (std::size_t i = 0; i < schedule.size(); i++)
+        {
+            const PersonPointers &move = schedule[i];
+            buffer += i ? ",{\"direction\":\"" : "{\"direction\":\"";
+            buffer += move.second_name != nullptr ? "forward" : "back";
+            buffer += "\",\"persons\":[";
+            appendQuoted(buffer, *move.first_name, format);
+            if (move.second_name != nullptr)
+            {
+                buffer += ',';
+                appendQuoted(buffer, *move.second_name, format);
+            }
+            for (std::uint64_t ones = move.other_persons; ones != 0; ones &= ones - 1)
+            {
+                buffer += ',';
+                appendQuoted(buffer, move.persons[__builtin_ctzll(ones)].name, format);
+            }
+            buffer += "],\"speed\":";
+            appendNumber(buffer, *move.speed);
+            buffer += '}';
+        }
+        buffer += "]}\n";
+        return;
+    }
+
+    if (format == format_csv)
+    {
+        std::string moves;
+        for (auto &it : schedule)
+            appendMove(moves, it);
+        if (!moves.empty())
+            moves.pop_back();
+        appendNumber(buffer, min_speed);
+        buffer += ',';
+        appendQuoted(buffer, moves, format);
+        buffer += '\n';
+        return;
+    }
+
+    for (auto &it : schedule)
+        appendMove(buffer, it);
+    buffer += "** minimal speed: ";
+    appendNumber(buffer, min_speed);
+    buffer += " **\n";
+}
+
+/**
+ * @brief appendError() function appends error of a group in one line to buffer
+ *
+ * @param buffer text to which error is appended
+ * @param message text of the error without "error: "
+ * @param format text, csv or ndjson
+ * @return no return
+ */
+inline void appendError(std::string &buffer, const std::string &message, const OutputFormat format = format_text)
+{
+    if (format == format_ndjson)
+    {
+        buffer += "{\"error\":";
+        appendQuoted(buffer, message, format);
+        buffer += "}\n";
+    }
+    else
+    {
+        buffer += format == format_csv ? "error," : "error: ";
+        appendQuoted(buffer, message, format);
+        buffer += '\n';
+    }
+}
+
+/**
+ * @brief appendCounts() function appends number of paths, speed of the quickest path and number of quickest paths in one line
+ *
+ * @param buffer text to which counts are appended
+ * @param counts numbers of paths from countPaths()
+ * @param format text ("paths: N minimal speed: X minimal paths: M"), csv ("X,N,M") or ndjson
+ * @return no return
+ */
+inline void appendCounts(std::string &buffer, const PathCounts &counts, const OutputFormat format = format_text)
+{
+    if (format == format_ndjson)
+    {
+        buffer += "{\"speed\":";
+        appendNumber(buffer, counts.speed);
+        buffer += ",\"paths\":" + counts.paths.toString() + ",\"minimal_paths\":" + counts.minimal_paths.toString() + "}\n";
+    }
+    else if (format == format_csv)
+    {
+        appendNumber(buffer, counts.speed);
+        buffer += "," + counts.paths.toString() + "," + counts.minimal_paths.toString() + "\n";
+    }
+    else
+    {
+        buffer += "paths: " + counts.paths.toString() + " minimal speed: ";
+        appendNumber(buffer, counts.speed);
+        buffer += " minimal paths: " + counts.minimal_paths.toString() + "\n";
+    }
+}
+
+/**
+ * @brief writeSchedule() function prints moves of a schedule and its total speed in one line
+ *
+ * @param schedule contains moves of the minimal path
+ * @param out stream in which schedule is printed
+ * @param format text, csv or ndjson
+ * @return no return
+ */
+inline void writeSchedule(const std::vector<PersonPointers> &schedule, std::ostream &out, const OutputFormat format = format_text)
+{
+    std::string buffer;
+    appendSchedule(buffer, schedule, format);
+    out.write(buffer.data(), buffer.size());
+}
+
+/**
+ * @brief printSchedule() function prints on screen one minimal schedule found by a solver
+ *
+ * @param schedule contains moves of the minimal path
+ * @param format text, csv or ndjson, only text has title line
+ * @return no return
+ */
+inline void printSchedule(const std::vector<PersonPointers> &schedule, const OutputFormat format = format_text)
+{
+    if (format == format_text)
+        std::cout << "\n***minimal speed ***" << "\n";
+    writeSchedule(schedule, std::cout, format);
+}
+
+
+/**
+ * @brief Class pathDump writes paths in binary file for other tools.
+ *
+ * File starts with header: 8 bytes "TUNPATH" and zero, then 32-bit numbers version, persons, movers (columns of persons
+ * in every move) and moves (of every path). Every path is 64-bit total speed and then for every move movers 16-bit
+ * columns of persons that move, ascending, unused ones are no_person. All records have same size and numbers are in
+ * byte order of the machine. Records are collected in buffer that is written in blocks of 1 MiB.
+ */
+class pathDump
+{
+    static const std::uint32_t dump_version = 2;     /**< version of layout of the file, 2 - 64-bit total speed*/
+
+    int m_file;                                     /**< descriptor of the file, -1 if file is not open*/
+    bool m_failed;                                  /**< some write failed*/
+    std::string m_buffer;                           /**< records that are not written yet*/
+    std::size_t m_block_size;                       /**< size of one write*/
+    PersonInformation *pointer_of_persons;          /**< pointer to array of structure PersonInformation*/
+    unsigned m_number_of_persons;                   /**< persons of the group*/
+    unsigned m_movers;                              /**< columns written for every move*/
+
+    /** @brief Function append() appends number as bytes of machine to the buffer.*/
+    template<typename T>
+    void append(const T value)
+    {
+        m_buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    /** @brief Function flush() writes whole buffer to the file.*/
+    void flush()
+    {
+        for (std::size_t written = 0; written < m_buffer.size() && !m_failed; )
+        {
+            const ssize_t count = ::write(m_file, m_buffer.data() + written, m_buffer.size() - written);
+            if (count < 0 && errno == EINTR)
+                continue;
+            if (count <= 0)
+                m_failed = true;
+            else
+                written += count;
+        }
+        m_buffer.clear();
+    }
+
+public:
+
+    /**
+     * @brief Constructor of a class creates the file and writes header.
+     *
+     * @param path path of the file
+     * @param p_of_persons pointer to array of structure PersonInformation to which paths point
+     * @param number_of_persons number of persons in array, less than 64
+     * @param movers columns written for every move, capacity of the tunnel
+     * @param moves number of moves of every path
+     */
+    pathDump(const std::string &path, PersonInformation *p_of_persons, const unsigned number_of_persons, const unsigned movers,
+             const unsigned moves)
+    : m_file(::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644)), m_failed(false), m_block_size(1 << 20),
+      pointer_of_persons(p_of_persons), m_number_of_persons(number_of_persons), m_movers(movers)
+    {
+        m_buffer.reserve(m_block_size + 8 + 2 * movers * moves);
+        m_buffer.append("TUNPATH", 8);
+        append<std::uint32_t>(dump_version);
+        append<std::uint32_t>(number_of_persons);
+        append<std::uint32_t>(movers);
+        append<std::uint32_t>(moves);
+    }
+
+    /** @brief Destructor of a class writes rest of buffer and closes the file.*/
+    ~pathDump() { finish(); }
+
+    pathDump(const pathDump&) = delete;
+    pathDump& operator= (const pathDump&) = delete;
+
+    /** @brief Function isOpen() returns true if file is created.*/
+    bool isOpen() const { return m_file >= 0; }
+
+    /**
+     * @brief Function write() appends one path to the file.
+     *
+     * @param path moves of the path
+     * @param speed total speed of the path
+     */
+    void write(const vector_of_persons &path, const unsigned long long speed)
+    {
+        append<std::uint64_t>(speed);
+        for (auto &it : path)
+        {
+            unsigned written = 0;
+            for (std::uint64_t columns = moveColumns(*it, pointer_of_persons, m_number_of_persons);
+                 columns != 0 && written < m_movers; columns &= columns - 1, written++)
+                append<person_index>(__builtin_ctzll(columns));
+            for (; written < m_movers; written++)
+                append<person_index>(no_person);
+        }
+
+        if (m_buffer.size() >= m_block_size)
+            flush();
+    }
+
+    /**
+     * @brief Function finish() writes rest of buffer and closes the file.
+     *
+     * @return true if all paths are written
+     */
+    bool finish()
+    {
+        if (m_file < 0)
+            return false;
+        flush();
+        m_failed = ::close(m_file) != 0 || m_failed;
+        m_file = -1;
+        return !m_failed;
+    }
+};
+
+/**
+ * @brief dumpPaths() function writes all paths to binary file and returns the quickest one
+ *
+ * @param paths source of all path solutions
+ * @param dump file to which paths are written
+ * @return moves of the first path with minimal total speed
+ */
+inline std::vector<PersonPointers> dumpPaths(pathSource &paths, pathDump &dump)
+{
+    stageTimer timer(solverStats::stage_print);
+    std::vector<PersonPointers> min_path;
+    unsigned long long minimal_speed = 0;
+
+    while (const vector_of_persons *p_path = paths.next())
+    {
+        dump.write(*p_path, paths.speed());
+        if (min_path.empty() || minimal_speed > paths.speed())
+        {
+            minimal_speed = paths.speed();
+            min_path.clear();
+            for (auto &it : *p_path)
+                min_path.push_back(*it);
+        }
+    }
+
+    return min_path;
+}
+
+
+using state_mask = std::uint64_t;  /**< people on the beginning of the tunnel, bit j is person j*/
+
+/**
+ * @brief shortestPath() function finds one minimal schedule with Dijkstra algorithm over states of the tunnel
+ *
+ * State is a pair of mask of people on the beginning of the tunnel and side of the flashlight. From the beginning two
+ * persons, or capacity persons, go forward (same rule as operator>>) and from the end one person returns (same rule as
+ * operator<<), so states are the rows of all generators, but only best speed and predecessor is kept for every state.
+ * Persons that go forward are combinations of set bits of the mask made with forEachCombination(). Paths are not
+ * materialized, time is O(states * transitions). Group must have less than 64 persons.
+ *
+ * @param p_of_persons pointer to array of structure PersonInformation
+ * @param number_of_persons number of persons in array
+ * @param capacity number of persons that go forward together, at least two, less persons only in the last move
+ * @return moves of one minimal schedule, empty if there are less than two persons
+ */
+inline std::vector<PersonPointers> shortestPath(PersonInformation *p_of_persons, const unsigned number_of_persons,
+                                                const unsigned capacity = 2)
+{
+    stageTimer timer(solverStats::stage_dijkstra);
+    struct StateInformation
+    {
+        unsigned long long speed;   /**< best total speed found for the state*/
+        state_mask previous;        /**< key of previous state*/
+        state_mask movers;          /**< persons of the move to this state*/
+        bool done;                  /**< best speed is final*/
+    };
+
+    std::vector<PersonPointers> schedule;
+    if (number_of_persons < 2 || number_of_persons >= state_word_bits || capacity < 2)
+        return schedule;
+
+    const state_mask all_persons = (state_mask(1) << number_of_persons) - 1;
+    auto key = [](state_mask mask, bool flashlight_on_end) { return (mask << 1) | (flashlight_on_end ? 1 : 0); };
+
+    std::unordered_map<state_mask, StateInformation> states;
+    using queue_entry = std::pair<unsigned long long, state_mask>;
+    std::priority_queue<queue_entry, std::vector<queue_entry>, std::greater<queue_entry>> queue;
+
+    unsigned long long settled_states = 0;
+    unsigned long long relaxed_edges = 0;
+
+    auto relax = [&](state_mask from, state_mask to, unsigned long long speed, state_mask movers)
+    {
+        ++relaxed_edges;
+        auto found = states.find(to);
+        if (found == states.end() || (!found->second.done && speed < found->second.speed))
+        {
+            states[to] = StateInformation{speed, from, movers, false};
+            queue.push(queue_entry(speed, to));
+        }
+    };
+
+    const state_mask start = key(all_persons, false);
+    const state_mask goal  = key(0, true);
+    states[start] = StateInformation{0, start, 0, false};
+    unsigned columns_of_ones[state_word_bits];
+    queue.push(queue_entry(0, start));
+
+    while (!queue.empty())
+    {
+        queue_entry top = queue.top();
+        queue.pop();
+
+        StateInformation &current = states[top.second];
+        if (current.done || top.first != current.speed)
+            continue;
+        current.done = true;
+        ++settled_states;
+        if (top.second == goal)
+            break;
+
+        state_mask mask = top.second >> 1;
+        bool flashlight_on_end = top.second & 1;
+
+        if (!flashlight_on_end)                        /**< forward->backward, two or capacity persons from beginning*/
+        {
+            unsigned found = 0;
+            for (state_mask ones = mask; ones != 0; ones &= ones - 1)
+                columns_of_ones[found++] = __builtin_ctzll(ones);
+            const unsigned travelers = std::min(capacity, found);
+
+            forEachCombination(columns_of_ones, found, travelers, [&](const unsigned *p_columns)
+            {
+                state_mask movers = 0;
+                unsigned speed = 0;
+                for (unsigned t = 0; t < travelers; t++)
+                {
+                    movers |= state_mask(1) << p_columns[t];
+                    speed = std::max(speed, p_of_persons[p_columns[t]].speed);
+                }
+                relax(top.second, key(mask & ~movers, true), top.first + speed, movers);
+            });
+        }
+        else                                           /**< backward->forward, one person from end returns*/
+        {
+            for (state_mask returning = all_persons & ~mask; returning != 0; returning &= returning - 1)
+            {
+                int a = __builtin_ctzll(returning);
+                relax(top.second, key(mask | (state_mask(1) << a), false), top.first + p_of_persons[a].speed, state_mask(1) << a);
+            }
+        }
+    }
+
+    stats().add(solverStats::counter_dijkstra_states, settled_states);
+    stats().add(solverStats::counter_dijkstra_edges, relaxed_edges);
+
+    for (state_mask current = goal; current != start; current = states[current].previous)  /**< reconstruct from predecessors*/
+        schedule.push_back(movePersons(p_of_persons, states[current].movers));
+
+    std::reverse(schedule.begin(), schedule.end());
+    return schedule;
+}
+
+
+/**
+ * @brief fastPath() function finds one minimal schedule with closed form strategy over sorted speeds
+ *
+ * Speeds are sorted and while more than three persons are on the beginning, two slowest are moved with cheaper of two
+ * strategies: two fastest shuttle (fastest two go, fastest returns, slowest two go, second fastest returns) or fastest
+ * escorts each (fastest goes with slowest, returns, goes with second slowest, returns). Last three or two persons go
+ * with the fastest. No generators are created, time is O(n log n). Strategy is for tunnel that carries two persons.
+ *
+ * @param p_of_persons pointer to array of structure PersonInformation
+ * @param number_of_persons number of persons in array
+ * @return moves of one minimal schedule, empty if there are less than two persons
+ */
+inline std::vector<PersonPointers> fastPath(PersonInformation *p_of_persons, const unsigned number_of_persons)
+{
+    stageTimer timer(solverStats::stage_fast);
+    std::vector<PersonPointers> schedule;
+    if (number_of_persons < 2)
+        return schedule;
+
+    std::vector<unsigned> order(number_of_persons);       /**< columns of persons sorted by speed*/
+    for (unsigned i = 0; i < number_of_persons; i++)
+        order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [p_of_persons](unsigned a, unsigned b)
+                     { return p_of_persons[a].speed < p_of_persons[b].speed; });
+
+    auto forward = [&](unsigned a, unsigned b)             /**< a is faster person*/
+    {
+        PersonPointers move;
+        move.first_name  = &p_of_persons[a].name;
+        move.second_name = &p_of_persons[b].name;
+        move.speed       = &p_of_persons[b].speed;
+        schedule.push_back(move);
+    };
+    auto backward = [&](unsigned a)
+    {
+        PersonPointers move;
+        move.first_name = &p_of_persons[a].name;
+        move.speed      = &p_of_persons[a].speed;
+        schedule.push_back(move);
+    };
+
+    const unsigned fastest = order[0];
+    const unsigned second  = order[1];
+    const unsigned long long t_fastest = p_of_persons[fastest].speed;
+    const unsigned long long t_second  = p_of_persons[second].speed;
+    unsigned remaining = number_of_persons;
+
+    while (remaining > 3)
+    {
+        const unsigned slowest        = order[remaining - 1];
+        const unsigned second_slowest = order[remaining - 2];
+
+        unsigned long long shuttle = t_fastest + 2 * t_second + p_of_persons[slowest].speed;
+        unsigned long long escort  = 2 * t_fastest + p_of_persons[second_slowest].speed + p_of_persons[slowest].speed;
+
+        if (shuttle <= escort)
+        {
+            forward(fastest, second);
+            backward(fastest);
+            forward(second_slowest, slowest);
+            backward(second);
+        }
+        else
+        {
+            forward(fastest, slowest);
+            backward(fastest);
+            forward(fastest, second_slowest);
+            backward(fastest);
+        }
+        remaining -= 2;
+    }
+
+    if (remaining == 3)
+    {
+        forward(fastest, order[2]);
+        backward(fastest);
+    }
+    forward(fastest, second);
+
+    return schedule;
+}
+
+/**
+ * @brief classPath() function finds one minimal schedule with Dijkstra algorithm over speed classes of persons
+ *
+ * Persons with same speed can change places in every schedule, so state is only number of persons of every speed class
+ * on the beginning of the tunnel and side of the flashlight, number of persons of a class is one digit of state in
+ * mixed radix. Forward move takes from classes numbers of persons that sum to two or capacity (or to all remaining
+ * persons in the last move), move back returns one person of a class, speed of move is speed of the slowest class in
+ * it. When many persons have same speed there are much less states and transitions than masks of shortestPath().
+ * Schedule with names is made at the end, persons of a class are taken from the side of the tunnel where they are.
+ *
+ * @param p_of_persons pointer to array of structure PersonInformation
+ * @param number_of_persons number of persons in array
+ * @param capacity number of persons that go forward together, at least two, less persons only in the last move
+ * @return moves of one minimal schedule, empty if there are less than two persons
+ */
+inline std::vector<PersonPointers> classPath(PersonInformation *p_of_persons, const unsigned number_of_persons,
+                                             const unsigned capacity = 2)
+{
+    stageTimer timer(solverStats::stage_classes);
+    struct SpeedClass
+    {
+        unsigned long long speed;       /**< speed of all persons of the class*/
+        std::vector<unsigned> columns;  /**< persons of the class*/
+        state_mask stride;              /**< value of one person of the class in state*/
+    };
+    struct StateInformation
+    {
+        unsigned long long speed;       /**< best total speed found for the state*/
+        state_mask previous;            /**< key of previous state*/
+        bool done;                      /**< best speed is final*/
+    };
+
+    std::vector<PersonPointers> schedule;
+    if (number_of_persons < 2 || number_of_persons >= state_word_bits || capacity < 2)
+        return schedule;
+
+    std::vector<unsigned> order(number_of_persons);          /**< columns of persons sorted by speed*/
+    for (unsigned i = 0; i < number_of_persons; i++)
+        order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [p_of_persons](unsigned a, unsigned b)
+                     { return p_of_persons[a].speed < p_of_persons[b].speed; });
+
+    std::vector<SpeedClass> classes;                          /**< classes from the fastest to the slowest*/
+    for (unsigned column : order)
+    {
+        if (classes.empty() || classes.back().speed != p_of_persons[column].speed)
+            classes.push_back(SpeedClass{p_of_persons[column].speed, std::vector<unsigned>(), 0});
+        classes.back().columns.push_back(column);
+    }
+
+    state_mask stride = 1;
+    for (auto &it : classes)
+    {
+        it.stride = stride;
+        stride *= it.columns.size() + 1;
+    }
+
+    auto key = [](state_mask state, bool flashlight_on_end) { return (state << 1) | (flashlight_on_end ? 1 : 0); };
+    auto count = [&classes](state_mask state, unsigned c) { return (unsigned) (state / classes[c].stride % (classes[c].columns.size() + 1)); };
+
+    std::unordered_map<state_mask, StateInformation> states;
+    using queue_entry = std::pair<unsigned long long, state_mask>;
+    std::priority_queue<queue_entry, std::vector<queue_entry>, std::greater<queue_entry>> queue;
+
+    auto relax = [&](state_mask from, state_mask to, unsigned long long speed)
+    {
+        auto found = states.find(to);
+        if (found == states.end() || (!found->second.done && speed < found->second.speed))
+        {
+            states[to] = StateInformation{speed, from, false};
+            queue.push(queue_entry(speed, to));
+        }
+    };
+
+    const state_mask start = key(stride - 1, false);          /**< every class full on beginning*/
+    const state_mask goal  = key(0, true);
+    states[start] = StateInformation{0, start, false};
+    queue.push(queue_entry(0, start));
+    unsigned long long settled_states = 0;
+
+    queue_entry top;
+    state_mask state = 0;
+    std::function<void(unsigned, unsigned, unsigned long long, state_mask)> choose =
+        [&](unsigned c, unsigned remaining, unsigned long long speed, state_mask moved)   /**< persons of classes c and after*/
+    {
+        if (remaining == 0)
+        {
+            relax(top.second, key(state - moved, true), top.first + speed);
+            return;
+        }
+        if (c == classes.size())
+            return;
+
+        const unsigned available = count(state, c);
+        for (unsigned t = 0; t <= available && t <= remaining; t++)
+            choose(c + 1, remaining - t, t > 0 ? classes[c].speed : speed, moved + t * classes[c].stride);
+    };
+
+    while (!queue.empty())
+    {
+        top = queue.top();
+        queue.pop();
+
+        StateInformation &current = states[top.second];
+        if (current.done || top.first != current.speed)
+            continue;
+        current.done = true;
+        ++settled_states;
+        if (top.second == goal)
+            break;
+
+        state = top.second >> 1;
+        if (!(top.second & 1))                                 /**< forward->backward, two or capacity persons*/
+        {
+            unsigned on_beginning = 0;
+            for (unsigned c = 0; c < classes.size(); c++)
+                on_beginning += count(state, c);
+            choose(0, std::min(capacity, on_beginning), 0, 0);
+        }
+        else                                                   /**< backward->forward, one person of a class returns*/
+        {
+            for (unsigned c = 0; c < classes.size(); c++)
+                if (count(state, c) < classes[c].columns.size())
+                    relax(top.second, key(state + classes[c].stride, false), top.first + classes[c].speed);
+        }
+    }
+
+    stats().add(solverStats::counter_class_states, settled_states);
+
+    std::vector<state_mask> path;
+    for (state_mask current = goal; current != start; current = states[current].previous)
+        path.push_back(current);
+    path.push_back(start);
+    std::reverse(path.begin(), path.end());
+
+    std::vector<std::vector<unsigned>> beginning(classes.size()), end(classes.size());   /**< persons of classes on sides*/
+    for (unsigned c = 0; c < classes.size(); c++)
+        beginning[c].assign(classes[c].columns.rbegin(), classes[c].columns.rend());
+
+    for (std::size_t i = 1; i < path.size(); i++)                /**< persons of classes to names*/
+    {
+        const bool forward = !(path[i - 1] & 1);
+        std::uint64_t movers = 0;
+
+        for (unsigned c = 0; c < classes.size(); c++)
+        {
+            unsigned before = count(path[i - 1] >> 1, c);
+            unsigned after  = count(path[i] >> 1, c);
+            std::vector<unsigned> &from = forward ? beginning[c] : end[c];
+            std::vector<unsigned> &to   = forward ? end[c] : beginning[c];
+
+            for (unsigned t = forward ? before - after : after - before; t > 0; t--)
+            {
+                movers |= std::uint64_t(1) << from.back();
+                to.push_back(from.back());
+                from.pop_back();
+            }
+        }
+        schedule.push_back(movePersons(p_of_persons, movers));
+    }
+
+    return schedule;
+}
+
+const unsigned fixed_max_persons = 16;      /**< biggest group of fixedSolver*/
+
+/**@brief Structure which contains schedule of fixedSolver in fixed array, moves are masks of persons that move*/
+struct fixedSchedule
+{
+    unsigned number_of_moves = 0;                        /**< moves of the schedule*/
+    unsigned long long speed = 0;                        /**< total speed of the schedule*/
+    std::uint32_t movers[2 * fixed_max_persons - 3];     /**< bit j is person j that moves*/
+};
+
+/**@brief Structure which contains one pair of persons that go forward together*/
+struct fixedPair
+{
+    std::uint32_t mask;        /**< bits of both persons*/
+    std::uint8_t first;        /**< column of first person*/
+    std::uint8_t second;       /**< column of second person*/
+};
+
+/** @brief Function fixedPairs() returns table of all pairs of N persons, made at compile time.*/
+template<unsigned N>
+constexpr std::array<fixedPair, N * (N - 1) / 2> fixedPairs()
+{
+    std::array<fixedPair, N * (N - 1) / 2> pairs{};
+    unsigned index = 0;
+    for (unsigned first = 0; first < N; first++)
+        for (unsigned second = first + 1; second < N; second++)
+            pairs[index++] = fixedPair{(std::uint32_t(1) << first) | (std::uint32_t(1) << second), (std::uint8_t) first, (std::uint8_t) second};
+    return pairs;
+}
+
+/**
+ * @brief Class fixedSolver finds minimal schedule of exactly N persons with tables and storage fixed at compile time.
+ *
+ * Tunnel carries two persons, so every round with flashlight on beginning has one person less on beginning and states
+ * are masks of persons on beginning. Forward speed of a mask is minimal speed to the end with flashlight on beginning,
+ * backward speed of a mask is minimal speed with flashlight on end, they are computed from masks with less persons up
+ * to the mask with all persons, masks of same number of persons are made with Gosper's hack. Pairs that go forward are
+ * taken from constexpr table and all speeds are in arrays of the object, so solver uses no heap, object of the biggest
+ * solver has 1152 KiB and lives on stack of the caller. Speeds are 64-bit, sum of 9-digit speeds does not fit in 32 bits.
+ */
+template<unsigned N>
+class fixedSolver
+{
+    static_assert(N >= 2 && N <= fixed_max_persons, "fixedSolver is for 2 to 16 persons");
+
+    static constexpr unsigned number_of_pairs = N * (N - 1) / 2;
+    static constexpr std::uint32_t all_persons = (std::uint32_t(1) << N) - 1;
+    static constexpr std::array<fixedPair, number_of_pairs> pairs = fixedPairs<N>();
+
+    std::array<unsigned long long, std::size_t(1) << N> m_forward;    /**< minimal speed with flashlight on beginning*/
+    std::array<unsigned long long, std::size_t(1) << N> m_backward;   /**< minimal speed with flashlight on end*/
+    std::array<std::uint8_t, std::size_t(1) << N> m_pair;       /**< pair of minimal forward move*/
+    std::array<std::uint8_t, std::size_t(1) << N> m_returning;  /**< person of minimal backward move*/
+
+    /** @brief Function nextMask() returns next bigger mask with same number of persons.*/
+    static std::uint32_t nextMask(const std::uint32_t mask)
+    {
+        const std::uint32_t lowest  = mask & (~mask + 1);
+        const std::uint32_t carried = mask + lowest;
+        return (((carried ^ mask) >> 2) / lowest) | carried;
+    }
+
+public:
+
+    /**
+     * @brief Function solve() finds minimal schedule of persons.
+     *
+     * @param p_of_persons pointer to array of N structures PersonInformation
+     * @param schedule structure in which minimal schedule is recorded
+     */
+    void solve(const PersonInformation *p_of_persons, fixedSchedule &schedule)
+    {
+        std::array<unsigned, N> speeds;
+        std::array<unsigned, number_of_pairs> pair_speeds;
+        for (unsigned i = 0; i < N; i++)
+            speeds[i] = p_of_persons[i].speed;
+        for (unsigned i = 0; i < number_of_pairs; i++)
+            pair_speeds[i] = std::max(speeds[pairs[i].first], speeds[pairs[i].second]);
+
+        for (unsigned on_beginning = 2; on_beginning <= N; on_beginning++)
+        {
+            for (std::uint32_t mask = (std::uint32_t(1) << on_beginning) - 1; mask <= all_persons; mask = nextMask(mask))
+            {
+                unsigned long long best = ~0ULL;
+                for (unsigned i = 0; i < number_of_pairs; i++)       /**< pairs of persons on beginning*/
+                {
+                    const std::uint32_t pair = pairs[i].mask;
+                    if ((pair & mask) != pair)
+                        continue;
+
+                    const unsigned long long speed = pair == mask ? pair_speeds[i] : pair_speeds[i] + m_backward[mask ^ pair];
+                    if (speed < best)
+                    {
+                        best = speed;
+                        m_pair[mask] = i;
+                    }
+                }
+                m_forward[mask] = best;
+            }
+
+            for (std::uint32_t mask = (std::uint32_t(1) << (on_beginning - 1)) - 1; mask < all_persons; mask = nextMask(mask))
+            {
+                unsigned long long best = ~0ULL;
+                for (unsigned r = 0; r < N; r++)                        /**< person on end that returns*/
+                {
+                    if ((mask >> r) & 1)
+                        continue;
+
+                    const unsigned long long speed = speeds[r] + m_forward[mask | (std::uint32_t(1) << r)];
+                    if (speed < best)
+                    {
+                        best = speed;
+                        m_returning[mask] = r;
+                    }
+                }
+                m_backward[mask] = best;
+            }
+        }
+
+        schedule.number_of_moves = 0;
+        schedule.speed = m_forward[all_persons];
+        for (std::uint32_t mask = all_persons; ; )
+        {
+            const std::uint32_t pair = pairs[m_pair[mask]].mask;
+            schedule.movers[schedule.number_of_moves++] = pair;
+            if (pair == mask)
+                break;
+
+            const std::uint32_t returning = std::uint32_t(1) << m_returning[mask ^ pair];
+            schedule.movers[schedule.number_of_moves++] = returning;
+            mask = (mask ^ pair) | returning;
+        }
+    }
+};
+
+/**
+ * @brief dispatchFixed() function calls fixedSolver of number_of_persons persons, chosen from N up to fixed_max_persons.
+ *
+ * @param p_of_persons pointer to array of structure PersonInformation
+ * @param number_of_persons number of persons in array
+ * @param schedule structure in which minimal schedule is recorded
+ * @return false if there is no fixedSolver for number_of_persons
+ */
+template<unsigned N = 2>
+inline bool dispatchFixed(const PersonInformation *p_of_persons, const unsigned number_of_persons, fixedSchedule &schedule)
+{
+    if constexpr (N > fixed_max_persons)
+        return false;
+    else
+    {
+        if (number_of_persons != N)
+            return dispatchFixed<N + 1>(p_of_persons, number_of_persons, schedule);
+
+        fixedSolver<N> solver;                                     /**< tables on stack, no heap*/
+        solver.solve(p_of_persons, schedule);
+        return true;
+    }
+}
+
+/**
+ * @brief fixedPath() function finds one minimal schedule with fixedSolver for groups of 2 to 16 persons
+ *
+ * Other groups and tunnels that carry more than two persons are solved with shortestPath().
+ *
+ * @param p_of_persons pointer to array of structure PersonInformation
+ * @param number_of_persons number of persons in array
+ * @param capacity number of persons that go forward together
+ * @return moves of one minimal schedule, empty if there are less than two persons
+ */
+inline std::vector<PersonPointers> fixedPath(PersonInformation *p_of_persons, const unsigned number_of_persons,
+                                             const unsigned capacity = 2)
+{
+    fixedSchedule fixed;
+    bool solved;
+    {
+        stageTimer timer(solverStats::stage_fixed);
+        solved = capacity == 2 && dispatchFixed(p_of_persons, number_of_persons, fixed);
+    }
+    if (!solved)
+        return shortestPath(p_of_persons, number_of_persons, capacity);
+
+    std::vector<PersonPointers> schedule;
+    schedule.reserve(fixed.number_of_moves);
+    for (unsigned i = 0; i < fixed.number_of_moves; i++)
+        schedule.push_back(movePersons(p_of_persons, fixed.movers[i]));
+    return schedule;
+}
+
+/**
+ * @brief scheduleSpeed() function returns total speed of a schedule
+ *
+ * @param schedule contains moves of a path
+ * @return sum of speeds of all moves
+ */
+inline unsigned long long scheduleSpeed(const std::vector<PersonPointers> &schedule)
+{
+    unsigned long long total_speed = 0;
+    for (auto &it : schedule)
+        total_speed += *it.speed;
+    return total_speed;
+}
+
+/**
+ * @brief greedyPath() function makes schedule in which fastest person escorts slowest persons
+ *
+ * Every forward move takes fastest person and capacity - 1 slowest persons on beginning, fastest person returns, and
+ * last move takes all remaining persons. Schedule is not always minimal, it is upper bound for boundPath().
+ *
+ * @param p_of_persons pointer to array of structure PersonInformation
+ * @param number_of_persons number of persons in array, less than 64
+ * @param capacity number of persons that go forward together
+ * @return moves of the schedule, empty if there are less than two persons
+ */
+inline std::vector<PersonPointers> greedyPath(PersonInformation *p_of_persons, const unsigned number_of_persons,
+                                              const unsigned capacity = 2)
+{
+    std::vector<PersonPointers> schedule;
+    if (number_of_persons < 2)
+        return schedule;
+
+    std::vector<unsigned> order(number_of_persons);       /**< columns of persons from slowest to fastest*/
+    for (unsigned i = 0; i < number_of_persons; i++)
+        order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [p_of_persons](unsigned a, unsigned b)
+                     { return p_of_persons[a].speed > p_of_persons[b].speed; });
+
+    const std::uint64_t fastest = std::uint64_t(1) << order.back();
+    std::uint64_t on_beginning = (number_of_persons == 64) ? ~std::uint64_t(0) : (std::uint64_t(1) << number_of_persons) - 1;
+
+    while ((unsigned) __builtin_popcountll(on_beginning) > capacity)
+    {
+        std::uint64_t movers = fastest;
+        for (unsigned i = 0, escorted = 0; escorted + 1 < capacity; i++)
+            if (((on_beginning >> order[i]) & 1) && (std::uint64_t(1) << order[i]) != fastest)
+            {
+                movers |= std::uint64_t(1) << order[i];
+                ++escorted;
+            }
+
+        schedule.push_back(movePersons(p_of_persons, movers));
+        schedule.push_back(movePersons(p_of_persons, fastest));
+        on_beginning &= ~movers;
+        on_beginning |= fastest;
+    }
+    schedule.push_back(movePersons(p_of_persons, on_beginning));
+
+    return schedule;
+}
+
+/**
+ * @brief boundPath() function finds one minimal schedule with branch and bound search over edges of generator chain
+ *
+ * Search walks paths like pathEnumerator, but carries speed of the path so far and cuts a row when that speed plus lower
+ * bound of the rest cannot be less than speed of the best schedule found so far. First best schedule is greedyPath().
+ * Lower bound counts persons on beginning from slowest: every forward move carries at most capacity of them, so the
+ * first, capacity + 1-th, 2 * capacity + 1-th slowest person each make one forward move at least that slow, and every
+ * remaining return is at least as slow as the fastest person. Bound never exceeds the rest of any path, so schedule is
+ * minimal. Row that was already reached with same or lower speed is also cut, rest of the path from it was searched.
+ * Edges of every row are walked from the fastest move, so good schedules are found early and cut more rows.
+ *
+ * @param start first generator of a chain with recorded edges
+ * @param p_of_persons pointer to array of structure PersonInformation of the chain
+ * @param number_of_persons number of persons in array, less than 64
+ * @param capacity number of persons that go forward together
+ * @return moves of one minimal schedule, empty if there are less than two persons
+ */
+inline std::vector<PersonPointers> boundPath(solutionsGenerator *start, PersonInformation *p_of_persons,
+                                             const unsigned number_of_persons, const unsigned capacity = 2)
+{
+    stageTimer timer(solverStats::stage_bound);
+    std::vector<PersonPointers> best = greedyPath(p_of_persons, number_of_persons, capacity);
+    if (best.empty() || start->m_edges.offsets == nullptr)
+        return best;
+
+    unsigned long long best_speed = scheduleSpeed(best);
+
+    std::vector<unsigned> order(number_of_persons);       /**< columns of persons from slowest to fastest*/
+    for (unsigned i = 0; i < number_of_persons; i++)
+        order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [p_of_persons](unsigned a, unsigned b)
+                     { return p_of_persons[a].speed > p_of_persons[b].speed; });
+    const unsigned long long fastest_speed = p_of_persons[order.back()].speed;
+    const unsigned directions_number = generatorChain::directions(number_of_persons, capacity);
+
+    std::vector<std::vector<unsigned long long>> reached;  /**< lowest speed with which rows of generators are reached*/
+    for (solutionsGenerator *p_generator = start; p_generator != nullptr; p_generator = p_generator->mp_next)
+        reached.emplace_back(p_generator->rows(), ~0ULL);
+
+    /**< lower bound of the rest of path from row of generator, forward generator has ones for persons on beginning*/
+    auto lowerBound = [&](const solutionsGenerator *p_generator, const bool forward, const map_path_row row, const unsigned round)
+    {
+        unsigned long long bound = (directions_number - 1 - round) * fastest_speed;
+        unsigned on_beginning = 0;
+        for (unsigned column : order)
+            if (p_generator->isOne(row, column) == forward && on_beginning++ % capacity == 0)
+                bound += p_of_persons[column].speed;
+        return bound;
+    };
+
+    struct Frame
+    {
+        solutionsGenerator *p_generator;   /**< generator whose edges are walked*/
+        std::size_t first;                 /**< first edge of the row in edges*/
+        std::size_t next;                  /**< next edge of the row in edges*/
+        unsigned long long speed;          /**< speed of path before edges of the row*/
+        unsigned round;                    /**< forward->backward move of the row*/
+        bool forward;                      /**< true for generator of persons on beginning*/
+    };
+
+    std::vector<Frame> frames;
+    std::vector<unsigned> edges;                            /**< edges of rows on stack, sorted by speed*/
+    std::vector<const PersonPointers*> path;
+    unsigned long long visited_rows = 1, cut_rows = 0;
+
+    auto pushRow = [&](solutionsGenerator *p_generator, const map_path_row row, const unsigned long long speed,
+                       const unsigned round, const bool forward)
+    {
+        const std::size_t first = edges.size();
+        for (unsigned edge = p_generator->m_edges.offsets[row]; edge < p_generator->m_edges.offsets[row + 1]; edge++)
+            edges.push_back(edge);
+        std::stable_sort(edges.begin() + first, edges.end(), [p_generator](unsigned a, unsigned b)
+                         { return p_generator->m_edges.speed[a] < p_generator->m_edges.speed[b]; });
+        frames.push_back(Frame{p_generator, first, first, speed, round, forward});
+    };
+    pushRow(start, 0, 0, 0, true);
+
+    while (!frames.empty())
+    {
+        Frame &top = frames.back();
+        if (top.next == edges.size())
+        {
+            edges.resize(top.first);
+            frames.pop_back();
+            continue;
+        }
+
+        const unsigned edge = edges[top.next++];
+        solutionsGenerator *p_generator = top.p_generator;
+        const unsigned long long speed  = top.speed + p_generator->m_edges.speed[edge];
+        const unsigned round            = top.forward ? top.round : top.round + 1;
+        const bool forward              = !top.forward;
+        path.resize(frames.size() - 1);
+        path.push_back(&p_generator->m_edges.persons[edge]);
+
+        solutionsGenerator *p_next = p_generator->mp_next;
+        if (p_next == nullptr || p_next->m_edges.offsets == nullptr)   /**< last generator, path is complete*/
+        {
+            if (speed < best_speed)
+            {
+                best_speed = speed;
+                best.clear();
+                for (const PersonPointers *p_move : path)
+                    best.push_back(*p_move);
+            }
+            continue;
+        }
+
+        const map_path_row row = p_generator->m_edges.successor[edge];
+        unsigned long long &reached_speed = reached[frames.size()][row];
+        if (speed >= reached_speed || speed + lowerBound(p_next, forward, row, round) >= best_speed)
+        {
+            ++cut_rows;
+            continue;
+        }
+        reached_speed = speed;
+
+        ++visited_rows;
+        pushRow(p_next, row, speed, round, forward);
+    }
+
+    stats().add(solverStats::counter_bound_rows, visited_rows);
+    stats().add(solverStats::counter_bound_cuts, cut_rows);
+
+    return best;
+}
+
+const unsigned incremental_max_persons = 16;  /**< biggest group of incrementalSolver, chain with spare columns of
+                                                   18 persons takes about 1 GB*/
+
+/**
+ * @brief Class incrementalSolver keeps minimal speeds of all rows of a generator chain and updates them after edits of group.
+ *
+ * Chain is made for more columns than persons, columns without person are inactive persons that stay on the end and
+ * their edges are skipped. Group of m persons starts at row of forward generator with m ones, so adding a person moves
+ * start one round earlier and removing moves it one round later, generators are not made again. For every row is kept
+ * minimal speed from the row to the end and its edge. After speed change, add or remove only edges of the person are
+ * checked: row is computed again when its best edge got slower or when the edge got faster than its speed, and changes
+ * go to rows before it through lists of predecessor edges, so only rows whose speed can change are computed. Rows of
+ * rounds before start are not updated and are computed when start moves to them. Tunnel carries two persons. Persons
+ * are identified by column, columns do not change while solver lives.
+ */
+class incrementalSolver
+{
+    static constexpr unsigned long long no_speed = ~0ULL;   /**< speed of row from which end is not reached*/
+
+    std::vector<PersonInformation> m_persons;               /**< persons by column, inactive columns have empty name*/
+    std::unique_ptr<generatorChain> mp_chain;               /**< chain for all columns*/
+    std::vector<solutionsGenerator*> m_levels;              /**< generators of the chain in order of moves*/
+    std::vector<std::vector<state_word>> m_movers;          /**< persons of every edge of every level*/
+    std::vector<std::vector<unsigned>> m_predecessors;      /**< edges of previous level sorted by successor row*/
+    std::vector<std::vector<unsigned>> m_predecessor_offsets;  /**< first predecessor edge of every row*/
+    std::vector<std::vector<unsigned>> m_person_edges;      /**< edges of every level in which person travels*/
+    std::vector<std::vector<unsigned long long>> m_speed;   /**< minimal speed from row to the end*/
+    std::vector<std::vector<unsigned>> m_best;              /**< edge of minimal speed of row*/
+    state_word m_inactive;                                  /**< columns without person*/
+    unsigned m_first_level;                                 /**< levels before it are not updated*/
+    unsigned m_spare;                                       /**< inactive columns added when chain is made again*/
+    unsigned long long m_recomputed;                        /**< rows computed by last edit*/
+
+    /** @brief Function rowOf() returns row of edge of level, every row of a generator has same number of edges.*/
+    map_path_row rowOf(const unsigned level, const unsigned edge) const
+    {
+        return edge / (m_levels[level]->m_edges.offsets[1] - m_levels[level]->m_edges.offsets[0]);
+    }
+
+    /** @brief Function startLevel() returns level of forward generator in which all active persons are on beginning.*/
+    unsigned startLevel() const { return 2 * (unsigned) __builtin_popcountll(m_inactive); }
+
+    /** @brief Function moveSpeed() returns speed of slowest person of movers.*/
+    unsigned moveSpeed(state_word movers) const
+    {
+        unsigned speed = 0;
+        for (; movers != 0; movers &= movers - 1)
+            speed = std::max(speed, m_persons[__builtin_ctzll(movers)].speed);
+        return speed;
+    }
+
+    /**
+     * @brief Function computeRow() computes minimal speed of row from speeds of next level.
+     *
+     * @return true if speed of the row changed
+     */
+    bool computeRow(const unsigned level, const map_path_row row)
+    {
+        const solutionsGenerator *p_generator = m_levels[level];
+        unsigned long long best = no_speed;
+        unsigned best_edge = 0;
+        for (unsigned edge = p_generator->m_edges.offsets[row]; edge < p_generator->m_edges.offsets[row + 1]; edge++)
+        {
+            if (m_movers[level][edge] & m_inactive)
+                continue;
+            const unsigned long long next = m_speed[level + 1][p_generator->m_edges.successor[edge]];
+            if (next != no_speed && p_generator->m_edges.speed[edge] + next < best)
+            {
+                best = p_generator->m_edges.speed[edge] + next;
+                best_edge = edge;
+            }
+        }
+
+        ++m_recomputed;
+        const bool changed = best != m_speed[level][row];
+        m_speed[level][row] = best;
+        m_best[level][row]  = best_edge;
+        return changed;
+    }
+
+    /** @brief Function computeLevel() computes minimal speeds of all rows of level.*/
+    void computeLevel(const unsigned level)
+    {
+        for (map_path_row row = 0; row < m_levels[level]->rows(); row++)
+            computeRow(level, row);
+    }
+
+    /**
+     * @brief Function build() makes chain for number_of_columns columns and computes speeds of all levels from start.
+     *
+     * Persons keep their columns, new columns are inactive.
+     */
+    void build(const unsigned number_of_columns)
+    {
+        m_persons.resize(number_of_columns);
+        m_inactive = 0;
+        for (unsigned j = 0; j < number_of_columns; j++)
+            if (m_persons[j].name.empty())
+                m_inactive |= state_word(1) << j;
+
+        mp_chain.reset();
+        mp_chain.reset(new generatorChain(m_persons.data(), number_of_columns));
+        m_levels.clear();
+        for (solutionsGenerator *p_generator = mp_chain->start(); p_generator != nullptr; p_generator = p_generator->mp_next)
+            m_levels.push_back(p_generator);
+
+        const unsigned number_of_levels = m_levels.size();
+        m_movers.assign(number_of_levels, {});
+        m_predecessors.assign(number_of_levels, {});
+        m_predecessor_offsets.assign(number_of_levels, {});
+        m_person_edges.assign((std::size_t) number_of_levels * number_of_columns, {});
+        m_speed.assign(number_of_levels, {});
+        m_best.assign(number_of_levels, {});
+
+        for (unsigned level = 0; level < number_of_levels; level++)
+        {
+            solutionsGenerator *p_generator = m_levels[level];
+            m_speed[level].assign(p_generator->rows(), no_speed);
+            m_best[level].assign(p_generator->rows(), 0);
+            m_predecessor_offsets[level].assign(p_generator->rows() + 1, 0);
+            if (level + 1 == number_of_levels)
+                continue;
+
+            const unsigned number_of_edges = p_generator->edges();
+            m_movers[level].resize(number_of_edges);
+            for (unsigned edge = 0; edge < number_of_edges; edge++)
+            {
+                state_word movers = state_word(1) << p_generator->m_edges.first_person[edge];
+                if (p_generator->m_edges.second_person[edge] != no_person)
+                    movers |= state_word(1) << p_generator->m_edges.second_person[edge];
+                if (p_generator->m_edges.other_persons != nullptr)
+                    movers |= p_generator->m_edges.other_persons[edge];
+                m_movers[level][edge] = movers;
+                for (state_word ones = movers; ones != 0; ones &= ones - 1)
+                    m_person_edges[(std::size_t) level * number_of_columns + __builtin_ctzll(ones)].push_back(edge);
+            }
+        }
+
+        for (unsigned level = 1; level < number_of_levels; level++)   /**< edges of previous level by successor*/
+        {
+            solutionsGenerator *p_previous = m_levels[level - 1];
+            std::vector<unsigned> &offsets = m_predecessor_offsets[level];
+            for (unsigned edge = 0; edge < p_previous->edges(); edge++)
+                ++offsets[p_previous->m_edges.successor[edge] + 1];
+            for (unsigned row = 0; row < m_levels[level]->rows(); row++)
+                offsets[row + 1] += offsets[row];
+
+            std::vector<unsigned> next(offsets.begin(), offsets.end() - 1);
+            m_predecessors[level].resize(p_previous->edges());
+            for (unsigned edge = 0; edge < p_previous->edges(); edge++)
+                m_predecessors[level][next[p_previous->m_edges.successor[edge]]++] = edge;
+        }
+
+        m_speed[number_of_levels - 1][0] = 0;                 /**< all persons on the end*/
+        m_first_level = startLevel();
+        for (unsigned level = number_of_levels - 1; level-- > m_first_level; )
+            computeLevel(level);
+    }
+
+    /**
+     * @brief Function update() gives column new speed and activity and updates speeds of rows from the last level to start.
+     *
+     * @param column column of the person
+     * @param speed new speed of the person
+     * @param active true if person is in group after the edit
+     */
+    void update(const unsigned column, const unsigned speed, const bool active)
+    {
+        stageTimer timer(solverStats::stage_incremental);
+        m_recomputed = 0;
+
+        const state_word old_inactive = m_inactive;
+        const unsigned old_first_level = m_first_level;
+        m_persons[column].speed = speed;
+        if (active)
+            m_inactive &= ~(state_word(1) << column);
+        else
+            m_inactive |= state_word(1) << column;
+
+        const unsigned number_of_columns = m_persons.size();
+        const unsigned start_level = startLevel();
+        const unsigned update_level = std::max(start_level, old_first_level);   /**< levels with valid speeds*/
+        std::vector<std::pair<map_path_row, unsigned long long>> changed, next_changed;   /**< rows and old speeds*/
+        std::vector<map_path_row> dirty;
+        std::vector<bool> marked;
+
+        for (unsigned level = m_levels.size() - 1; level-- > update_level; )
+        {
+            solutionsGenerator *p_generator = m_levels[level];
+            marked.assign(p_generator->rows(), false);
+            dirty.clear();
+            auto mark = [&](const map_path_row row)
+            {
+                if (!marked[row])
+                {
+                    marked[row] = true;
+                    dirty.push_back(row);
+                }
+            };
+
+            for (unsigned edge : m_person_edges[(std::size_t) level * number_of_columns + column])   /**< edges of the person*/
+            {
+                const state_word movers = m_movers[level][edge];
+                const unsigned long long old_speed = (movers & old_inactive) ? no_speed : p_generator->m_edges.speed[edge];
+                p_generator->m_edges.speed[edge] = moveSpeed(movers);
+                const unsigned long long new_speed = (movers & m_inactive) ? no_speed : p_generator->m_edges.speed[edge];
+
+                const map_path_row row = rowOf(level, edge);
+                const unsigned long long next = m_speed[level + 1][p_generator->m_edges.successor[edge]];
+                if (new_speed > old_speed ? m_best[level][row] == edge :
+                    new_speed < old_speed && next != no_speed && new_speed + next < m_speed[level][row])
+                    mark(row);
+            }
+
+            for (auto &row_change : changed)                      /**< rows of next level with new speed*/
+            {
+                const unsigned long long new_speed = m_speed[level + 1][row_change.first];
+                const std::vector<unsigned> &offsets = m_predecessor_offsets[level + 1];
+                for (unsigned i = offsets[row_change.first]; i < offsets[row_change.first + 1]; i++)
+                {
+                    const unsigned edge = m_predecessors[level + 1][i];
+                    const map_path_row row = rowOf(level, edge);
+                    if (new_speed > row_change.second ? m_best[level][row] == edge :
+                        new_speed != no_speed && !(m_movers[level][edge] & m_inactive) &&
+                        p_generator->m_edges.speed[edge] + new_speed < m_speed[level][row])
+                        mark(row);
+                }
+            }
+
+            next_changed.clear();
+            for (map_path_row row : dirty)
+            {
+                const unsigned long long old_speed = m_speed[level][row];
+                if (computeRow(level, row))
+                    next_changed.emplace_back(row, old_speed);
+            }
+            changed.swap(next_changed);
+        }
+
+        for (unsigned level = 0; level < update_level; level++)   /**< edge speeds of levels that are not updated*/
+            for (unsigned edge : m_person_edges[(std::size_t) level * number_of_columns + column])
+                m_levels[level]->m_edges.speed[edge] = moveSpeed(m_movers[level][edge]);
+
+        for (unsigned level = update_level; level-- > start_level; )   /**< start moved to earlier round*/
+            computeLevel(level);
+        m_first_level = start_level;
+
+        stats().add(solverStats::counter_incremental_rows, m_recomputed);
+    }
+
+public:
+
+    /**
+     * @brief Constructor of a class makes chain for persons and spare columns and computes minimal speeds.
+     *
+     * @param p_of_persons pointer to array of structure PersonInformation, persons get columns 0 to number_of_persons - 1
+     * @param number_of_persons number of persons in array, at least two
+     * @param spare_persons number of persons that can be added before chain is made again
+     */
+    incrementalSolver(const PersonInformation *p_of_persons, const unsigned number_of_persons, const unsigned spare_persons = 2)
+    : m_persons(p_of_persons, p_of_persons + number_of_persons), m_inactive(0), m_first_level(0), m_spare(spare_persons),
+      m_recomputed(0)
+    {
+        stageTimer timer(solverStats::stage_incremental);
+        build(number_of_persons + spare_persons);
+    }
+
+    incrementalSolver(const incrementalSolver&) = delete;
+    incrementalSolver& operator= (const incrementalSolver&) = delete;
+
+    /**
+     * @brief Function setSpeed() changes speed of person and updates minimal schedule.
+     *
+     * @param column column of active person
+     * @param speed new speed
+     */
+    void setSpeed(const unsigned column, const unsigned speed) { update(column, speed, true); }
+
+    /**
+     * @brief Function addPerson() adds person to group and updates minimal schedule.
+     *
+     * Person gets first inactive column, chain is made again with spare columns only when there is no inactive column.
+     *
+     * @param name name of the person
+     * @param speed speed of the person
+     * @return column of the person, no_person if group has incremental_max_persons persons
+     */
+    unsigned addPerson(const std::string &name, const unsigned speed)
+    {
+        if (persons() >= incremental_max_persons)
+            return no_person;
+
+        unsigned column = 0;
+        while (column < m_persons.size() && !((m_inactive >> column) & 1))
+            ++column;
+
+        if (column == m_persons.size())                          /**< no inactive column*/
+        {
+            if (column + 1 + m_spare >= state_word_bits)
+                return no_person;
+            m_persons.push_back(PersonInformation{name, speed});
+            m_recomputed = 0;
+            stageTimer timer(solverStats::stage_incremental);
+            build(column + 1 + m_spare);
+            return column;
+        }
+
+        m_persons[column].name = name;
+        update(column, speed, true);
+        return column;
+    }
+
+    /**
+     * @brief Function removePerson() removes person from group and updates minimal schedule.
+     *
+     * @param column column of active person
+     * @return false if group would have less than two persons
+     */
+    bool removePerson(const unsigned column)
+    {
+        if (persons() <= 2)
+            return false;
+        update(column, m_persons[column].speed, false);
+        m_persons[column].name.clear();
+        return true;
+    }
+
+    /** @brief Function findPerson() returns column of active person with name, or no_person.*/
+    unsigned findPerson(const std::string &name) const
+    {
+        for (unsigned j = 0; j < m_persons.size(); j++)
+            if (!((m_inactive >> j) & 1) && m_persons[j].name == name)
+                return j;
+        return no_person;
+    }
+
+    /** @brief Function persons() returns number of active persons.*/
+    unsigned persons() const { return m_persons.size() - __builtin_popcountll(m_inactive); }
+
+    /** @brief Function recomputed() returns number of rows computed by last edit.*/
+    unsigned long long recomputed() const { return m_recomputed; }
+
+    /** @brief Function speed() returns total speed of minimal schedule.*/
+    unsigned long long speed() const
+    {
+        state_word start_row = ~m_inactive & ((state_word(1) << m_persons.size()) - 1);
+        return m_speed[startLevel()][m_levels[startLevel()]->rowIndex(&start_row)];
+    }
+
+    /**
+     * @brief Function schedule() returns moves of minimal schedule.
+     *
+     * @return moves that point to persons of the solver, valid until next edit
+     */
+    std::vector<PersonPointers> schedule()
+    {
+        std::vector<PersonPointers> moves;
+        state_word start_row = ~m_inactive & ((state_word(1) << m_persons.size()) - 1);
+        map_path_row row = m_levels[startLevel()]->rowIndex(&start_row);
+        for (unsigned level = startLevel(); level + 1 < m_levels.size(); level++)
+        {
+            const unsigned edge = m_best[level][row];
+            moves.push_back(movePersons(m_persons.data(), m_movers[level][edge]));
+            row = m_levels[level]->m_edges.successor[edge];
+        }
+        return moves;
+    }
+};
+
+/**
+ * @brief Class wideFrontier holds states of one round of largePath(), persons on beginning are masks of any width.
+ *
+ * Masks of all states are in one contiguous array of words and are found with open addressing table of state indexes,
+ * so state that is reached more times is kept once with the lowest speed. For every state index of previous state and
+ * columns of persons that went forward and returned are kept, they are the step of the schedule.
+ */
+class wideFrontier
+{
+    unsigned m_words;                          /**< state_word words of one mask*/
+    unsigned m_move_columns;                   /**< columns of one step, persons that go forward and returning person*/
+    std::vector<state_word> m_masks;           /**< masks of all states*/
+    std::vector<unsigned long long> m_speeds;  /**< speed of path to state*/
+    std::vector<std::uint64_t> m_previous;     /**< index of state of previous round*/
+    std::vector<person_index> m_moves;         /**< m_move_columns columns for every state*/
+    std::vector<std::size_t> m_table;          /**< state index + 1 by hash of mask, 0 is empty*/
+
+    /** @brief Function hash() mixes words of mask.*/
+    std::size_t hash(const state_word *p_mask) const
+    {
+        std::uint64_t h = 0x9E3779B97F4A7C15ULL;
+        for (unsigned w = 0; w < m_words; w++)
+        {
+            h ^= p_mask[w] + 0x9E3779B97F4A7C15ULL + (h << 6) + (h >> 2);
+            h *= 0xBF58476D1CE4E5B9ULL;
+        }
+        return h ^ (h >> 31);
+    }
+
+public:
+
+    /** @brief Constructor of a class for masks of number_of_words words and steps of move_columns columns.*/
+    wideFrontier(const unsigned number_of_words, const unsigned move_columns)
+    : m_words(number_of_words), m_move_columns(move_columns), m_table(64, 0) {}
+
+    /** @brief Function clear() removes all states and keeps memory.*/
+    void clear()
+    {
+        m_masks.clear();
+        m_speeds.clear();
+        m_previous.clear();
+        m_moves.clear();
+        std::fill(m_table.begin(), m_table.end(), 0);
+    }
+
+    /**
+     * @brief Function insert() adds state or lowers speed of state that is already in frontier.
+     *
+     * @param p_mask pointer to m_words words of persons on beginning
+     * @param speed speed of path to the state
+     * @param previous index of state of previous round
+     * @param p_moves pointer to columns of the step
+     */
+    void insert(const state_word *p_mask, const unsigned long long speed, const std::uint64_t previous, const person_index *p_moves)
+    {
+        if (2 * (size() + 1) > m_table.size())                  /**< table at most half full*/
+        {
+            m_table.assign(2 * m_table.size(), 0);
+            for (std::size_t i = 0; i < size(); i++)
+            {
+                std::size_t slot = hash(mask(i)) & (m_table.size() - 1);
+                while (m_table[slot] != 0)
+                    slot = (slot + 1) & (m_table.size() - 1);
+                m_table[slot] = i + 1;
+            }
+        }
+
+        std::size_t slot = hash(p_mask) & (m_table.size() - 1);
+        for (; m_table[slot] != 0; slot = (slot + 1) & (m_table.size() - 1))
+        {
+            const std::size_t i = m_table[slot] - 1;
+            if (!std::equal(p_mask, p_mask + m_words, mask(i)))
+                continue;
+            if (speed < m_speeds[i])
+            {
+                m_speeds[i]   = speed;
+                m_previous[i] = previous;
+                std::copy(p_moves, p_moves + m_move_columns, m_moves.begin() + i * m_move_columns);
+            }
+            return;
+        }
+
+        m_table[slot] = size() + 1;
+        m_masks.insert(m_masks.end(), p_mask, p_mask + m_words);
+        m_speeds.push_back(speed);
+        m_previous.push_back(previous);
+        m_moves.insert(m_moves.end(), p_moves, p_moves + m_move_columns);
+    }
+
+    /** @brief Function size() returns number of states.*/
+    std::size_t size() const { return m_speeds.size(); }
+
+    /** @brief Function mask() returns pointer to words of mask of state i.*/
+    const state_word* mask(const std::size_t i) const { return m_masks.data() + i * m_words; }
+
+    /** @brief Function speed() returns speed of path to state i.*/
+    unsigned long long speed(const std::size_t i) const { return m_speeds[i]; }
+
+    /** @brief Function previous() returns array of indexes of previous states of all states.*/
+    const std::vector<std::uint64_t>& previous() const { return m_previous; }
+
+    /** @brief Function moves() returns array of columns of steps of all states.*/
+    const std::vector<person_index>& moves() const { return m_moves; }
+};
+
+const std::size_t large_beam_states = 8;  /**< states of every round in first pass of largePath()*/
+
+/**
+ * @brief largePath() function finds one minimal schedule of big group with dynamic programming over rounds
+ *
+ * States of round are masks of persons on beginning with flashlight on beginning, masks have as many state_word words
+ * as group needs. Every round capacity persons go forward and one person returns, so states of next round are made only
+ * from states of current round and only these two frontiers are in memory. Columns of masks are persons sorted from the
+ * slowest to the fastest and persons with same speed can change places, so of every speed class only first columns are
+ * on beginning, only last of them go forward and only first of them on end returns (same reduction as classPath()).
+ *
+ * Lower bound of the rest counts every move forward at least as its slowest persons, every return at least as the
+ * fastest person, persons that return are carried forward again and the fastest person is in at most one place of a
+ * move, bound is minimum over number of returns of the fastest person. First pass keeps only large_beam_states states
+ * with the smallest speed plus lower bound in every round and its schedule is upper bound, second pass keeps every
+ * state that can be quicker than upper bound, so it finds minimal schedule or there is no quicker one. In second pass
+ * index of previous state and step of every state are written to memory, or to spill file when it is given, and
+ * schedule is read back from them when last round is done. Every call spills to own file spill_file.N that is removed
+ * at the end, so more threads can solve with same spill_file. Masks take up to 65534 persons, for capacity above two
+ * less than 64 persons, because third and further persons of one move are columns of other_persons as in movePersons().
+ * Time of second pass still grows exponentially with number of different speeds: for capacity two 64 persons of
+ * different speeds take about 5 s and 100 persons more than a minute, for capacity 3 and 4 about 20 to 24 persons of
+ * different speeds take seconds and 32 persons tens of seconds. Groups of few speed classes are fast, 63 persons of 8
+ * classes take less than 0.1 s. So solveGroup() solves groups of capacity two with fastPath().
+ *
+ * @param p_of_persons pointer to array of structure PersonInformation
+ * @param number_of_persons number of persons in array
+ * @param capacity number of persons that go forward together, at least two, less persons only in the last move
+ * @param spill_file prefix of file for steps of all rounds, empty - steps are kept in memory
+ * @return moves of one minimal schedule, empty if group is not supported or spill file cannot be used
+ */
+inline std::vector<PersonPointers> largePath(PersonInformation *p_of_persons, const unsigned number_of_persons,
+                                             const unsigned capacity = 2, const std::string &spill_file = std::string())
+{
+    stageTimer timer(solverStats::stage_large);
+    std::vector<PersonPointers> schedule;
+    if (number_of_persons < 2 || number_of_persons >= no_person || capacity < 2 ||
+        (capacity > 2 && number_of_persons >= state_word_bits))
+        return schedule;
+
+    const unsigned words = (number_of_persons + state_word_bits - 1) / state_word_bits;
+    const unsigned move_columns = capacity + 1;
+
+    std::vector<unsigned> order(number_of_persons);       /**< persons of columns from the slowest to the fastest*/
+    for (unsigned i = 0; i < number_of_persons; i++)
+        order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [p_of_persons](unsigned a, unsigned b)
+                     { return p_of_persons[a].speed > p_of_persons[b].speed; });
+
+    std::vector<unsigned> speed(number_of_persons), class_of(number_of_persons), class_begin;
+    for (unsigned i = 0; i < number_of_persons; i++)
+    {
+        speed[i] = p_of_persons[order[i]].speed;
+        if (i == 0 || speed[i] != speed[i - 1])
+            class_begin.push_back(i);
+        class_of[i] = class_begin.size() - 1;
+    }
+    class_begin.push_back(number_of_persons);
+
+    auto isOne = [](const state_word *p_mask, const unsigned column) { return (p_mask[column / state_word_bits] >> (column % state_word_bits)) & 1; };
+
+    const unsigned long long fastest_speed = speed[number_of_persons - 1];
+    const unsigned long long pair_speed = speed[number_of_persons - 2];   /**< every forward move has two persons*/
+    const unsigned long long full_speed = speed[number_of_persons - std::min(capacity, number_of_persons)];   /**< and capacity before the last*/
+    std::vector<unsigned long long> slowest, every_move, every_escort;
+    auto lowerBound = [&](const state_word *p_mask, const unsigned on_beginning)
+    {
+        const unsigned forward_moves = on_beginning <= capacity ? 1 : 1 + (on_beginning - 2) / (capacity - 1);
+        const unsigned returns = forward_moves - 1;
+        const unsigned fastest_on_beginning = isOne(p_mask, number_of_persons - 1);   /**< whole fastest class*/
+        const unsigned others = on_beginning - fastest_on_beginning;
+
+        slowest.clear();                                    /**< persons on beginning without the fastest one*/
+        for (unsigned w = 0; w < words && slowest.size() < others; w++)
+            for (state_word ones = p_mask[w]; ones != 0 && slowest.size() < others; ones &= ones - 1)
+                slowest.push_back(speed[w * state_word_bits + __builtin_ctzll(ones)]);
+        every_move.assign(1, 0);                            /**< sums of every capacity-th slowest*/
+        for (unsigned i = 0; i < others; i += capacity)
+            every_move.push_back(every_move.back() + std::max(slowest[i], full_speed));
+        every_escort.assign(others + capacity, 0);          /**< sums of every (capacity - 1)-th slowest from i*/
+        for (unsigned i = others; i-- > 0; )
+            every_escort[i] = std::max(slowest[i], full_speed) + every_escort[i + capacity - 1];
+
+        unsigned long long bound = ~0ULL;
+        for (unsigned x = 0; x <= returns; x++)             /**< x returns of the fastest, others at least pair_speed*/
+        {
+            const unsigned escorts = x + fastest_on_beginning;              /**< moves with the fastest person*/
+            const unsigned moves = forward_moves - escorts;
+            const unsigned full_moves = std::min<unsigned>(moves, every_move.size() - 1);
+            unsigned long long total = every_move[full_moves] + (moves - full_moves) * full_speed;
+
+            const unsigned first = capacity * moves;
+            const unsigned escort_moves = first < others ? std::min(escorts, (others - first + capacity - 2) / (capacity - 1)) : 0;
+            if (escort_moves > 0)
+                total += every_escort[first] - every_escort[first + escort_moves * (capacity - 1)];
+            total += (escorts - escort_moves) * full_speed;
+
+            const unsigned last = escorts > 0 ? first + (escorts - 1) * (capacity - 1) : (moves - 1) * capacity;
+            const unsigned long long last_speed = last < others ? slowest[last] : last < others + returns - x ? pair_speed : 0;
+            total -= std::max(last_speed, full_speed) - std::max(last_speed, pair_speed);   /**< only last move has two persons*/
+
+            bound = std::min(bound, total + x * fastest_speed + (returns - x) * pair_speed);
+        }
+        return bound;
+    };
+
+    static std::atomic<unsigned long long> spill_number(0);
+    const std::string spill_path = spill_file.empty() ? spill_file : spill_file + "." + std::to_string(++spill_number);
+    struct spillRemover
+    {
+        const std::string &path;
+        ~spillRemover() { if (!path.empty()) std::remove(path.c_str()); }
+    } remover{spill_path};
+    const std::size_t record_bytes = sizeof(std::uint64_t) + move_columns * sizeof(person_index);
+
+    wideFrontier current(words, move_columns), next(words, move_columns), kept(words, move_columns);
+    std::vector<state_word> forward_mask(words);
+    std::vector<person_index> step(move_columns, no_person);
+    std::vector<std::pair<unsigned, unsigned>> on_beginning_of_class;   /**< class and its persons on beginning*/
+    std::vector<std::pair<unsigned long long, std::size_t>> ranked;     /**< speed plus lower bound of states*/
+    unsigned long long states = 0, dropped = 0;
+
+    unsigned long long bound_speed = 1;                     /**< states are dropped from this speed, speed of the best schedule*/
+    for (unsigned remaining = number_of_persons, slow = 0; ; )   /**< fastest escorts capacity - 1 slowest persons*/
+    {
+        bound_speed += speed[slow];
+        if (remaining <= capacity)
+            break;
+        bound_speed += fastest_speed;
+        slow      += capacity - 1;
+        remaining -= capacity - 1;
+    }
+    std::vector<person_index> best_steps, last_move;        /**< steps of the best schedule from the last round and its last move*/
+
+    /** One pass over all rounds with at most beam states in a round (0 - all states), steps go to spill file if path is not empty.*/
+    auto rounds = [&](const std::size_t beam, const std::string &path)
+    {
+        std::fstream spill;                                 /**< steps of rounds, one record of fixed size for every state*/
+        std::vector<std::uint64_t> layer_offsets(1, 0);     /**< first state of every round in steps*/
+        std::vector<std::uint64_t> previous_steps;
+        std::vector<person_index> move_steps;
+        if (!path.empty())
+        {
+            spill.open(path, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+            if (!spill)
+                return false;
+        }
+
+        current.clear();
+        std::fill(forward_mask.begin(), forward_mask.end(), 0);
+        for (unsigned j = 0; j < number_of_persons; j++)
+            forward_mask[j / state_word_bits] |= state_word(1) << (j % state_word_bits);
+        std::fill(step.begin(), step.end(), no_person);
+        current.insert(forward_mask.data(), 0, 0, step.data());
+        ++states;
+
+        std::size_t s = 0;
+        unsigned on_beginning = number_of_persons;
+        std::function<void(unsigned, unsigned, unsigned)> choose = [&](unsigned i, unsigned chosen, unsigned move_speed)
+        {
+            if (chosen < capacity)                              /**< last persons of classes on beginning go*/
+            {
+                for (; i < on_beginning_of_class.size(); i++)
+                {
+                    const unsigned c = on_beginning_of_class[i].first, available = on_beginning_of_class[i].second;
+                    for (unsigned t = 1; t <= available && chosen + t <= capacity; t++)
+                    {
+                        step[chosen + t - 1] = class_begin[c] + available - t;
+                        choose(i + 1, chosen + t, move_speed == 0 ? speed[class_begin[c]] : move_speed);
+                    }
+                }
+                return;
+            }
+
+            const state_word *p_mask = current.mask(s);
+            std::copy(p_mask, p_mask + words, forward_mask.begin());
+            for (unsigned t = 0; t < capacity; t++)
+                forward_mask[step[t] / state_word_bits] &= ~(state_word(1) << (step[t] % state_word_bits));
+
+            for (unsigned c = class_begin.size() - 1; c-- > 0; )   /**< first person of class on end returns*/
+            {
+                unsigned r = class_begin[c];
+                while (r < class_begin[c + 1] && isOne(forward_mask.data(), r))
+                    ++r;
+                if (r == class_begin[c + 1])
+                    continue;
+
+                const unsigned long long path_speed = current.speed(s) + move_speed + speed[r];
+                forward_mask[r / state_word_bits] |= state_word(1) << (r % state_word_bits);
+                const bool drop = path_speed + lowerBound(forward_mask.data(), on_beginning - capacity + 1) >= bound_speed;
+                if (!drop)
+                {
+                    step[capacity] = r;
+                    next.insert(forward_mask.data(), path_speed, s, step.data());
+                }
+                forward_mask[r / state_word_bits] &= ~(state_word(1) << (r % state_word_bits));
+                if (drop)
+                {
+                    ++dropped;
+                    if (c + 2 < class_begin.size())             /**< slower persons than dropped one are dropped too*/
+                        break;
+                }
+            }
+        };
+
+        for (; on_beginning > capacity; on_beginning -= capacity - 1)
+        {
+            next.clear();
+            for (s = 0; s < current.size(); s++)
+            {
+                on_beginning_of_class.clear();
+                for (unsigned w = 0; w < words; w++)
+                    for (state_word ones = current.mask(s)[w]; ones != 0; ones &= ones - 1)
+                    {
+                        const unsigned c = class_of[w * state_word_bits + __builtin_ctzll(ones)];
+                        if (on_beginning_of_class.empty() || on_beginning_of_class.back().first != c)
+                            on_beginning_of_class.emplace_back(c, 0);
+                        ++on_beginning_of_class.back().second;
+                    }
+                choose(0, 0, 0);
+            }
+
+            if (beam > 0 && next.size() > beam)                 /**< only states with the smallest bound stay*/
+            {
+                ranked.clear();
+                for (std::size_t i = 0; i < next.size(); i++)
+                    ranked.emplace_back(next.speed(i) + lowerBound(next.mask(i), on_beginning - capacity + 1), i);
+                std::nth_element(ranked.begin(), ranked.begin() + beam, ranked.end());
+                dropped += next.size() - beam;
+                ranked.resize(beam);
+                std::sort(ranked.begin(), ranked.end(), [](const std::pair<unsigned long long, std::size_t> &a,
+                          const std::pair<unsigned long long, std::size_t> &b) { return a.second < b.second; });
+
+                kept.clear();
+                for (auto &it : ranked)
+                    kept.insert(next.mask(it.second), next.speed(it.second), next.previous()[it.second],
+                                &next.moves()[it.second * move_columns]);
+                std::swap(next, kept);
+            }
+
+            states += next.size();
+            if (spill.is_open())
+            {
+                for (s = 0; s < next.size(); s++)
+                {
+                    spill.write((const char*) &next.previous()[s], sizeof(std::uint64_t));
+                    spill.write((const char*) &next.moves()[s * move_columns], move_columns * sizeof(person_index));
+                }
+                if (!spill)
+                    return false;
+            }
+            else
+            {
+                previous_steps.insert(previous_steps.end(), next.previous().begin(), next.previous().end());
+                move_steps.insert(move_steps.end(), next.moves().begin(), next.moves().end());
+            }
+            layer_offsets.push_back(layer_offsets.back() + next.size());
+            std::swap(current, next);
+        }
+
+        std::size_t best = current.size();                  /**< last move takes all persons on beginning*/
+        for (s = 0; s < current.size(); s++)
+        {
+            unsigned last_speed = 0;
+            for (unsigned w = 0; w < words && last_speed == 0; w++)     /**< first one is the slowest*/
+                if (current.mask(s)[w] != 0)
+                    last_speed = speed[w * state_word_bits + __builtin_ctzll(current.mask(s)[w])];
+            if (current.speed(s) + last_speed < bound_speed)
+            {
+                bound_speed = current.speed(s) + last_speed;
+                best = s;
+            }
+        }
+        if (best == current.size())                         /**< no quicker schedule*/
+            return true;
+
+        last_move.clear();
+        for (unsigned j = 0; j < number_of_persons; j++)
+            if (isOne(current.mask(best), j))
+                last_move.push_back(j);
+
+        best_steps.clear();
+        for (std::size_t round = layer_offsets.size() - 1; round > 0; round--)
+        {
+            const std::uint64_t record = layer_offsets[round - 1] + best;
+            std::uint64_t previous;
+            if (spill.is_open())
+            {
+                spill.seekg(record * record_bytes);
+                spill.read((char*) &previous, sizeof(previous));
+                spill.read((char*) step.data(), move_columns * sizeof(person_index));
+                if (!spill)
+                    return false;
+            }
+            else
+            {
+                previous = previous_steps[record];
+                std::copy(move_steps.begin() + record * move_columns, move_steps.begin() + (record + 1) * move_columns, step.begin());
+            }
+
+            best_steps.insert(best_steps.end(), step.begin(), step.end());
+            best = previous;
+        }
+        return true;
+    };
+
+    if (!rounds(large_beam_states, std::string()))
+        return schedule;
+    if (best_steps.empty() && last_move.empty())            /**< escort schedule was cut from states of beam*/
+    {
+        bound_speed = ~0ULL;
+        rounds(large_beam_states, std::string());
+    }
+    if (!rounds(0, spill_path))
+        return schedule;
+    stats().add(solverStats::counter_large_states, states);
+    stats().add(solverStats::counter_large_dropped, dropped);
+
+    std::vector<std::vector<unsigned>> beginning(class_begin.size() - 1), end(class_begin.size() - 1);   /**< persons of classes on sides*/
+    for (unsigned i = 0; i < number_of_persons; i++)
+        beginning[class_of[i]].push_back(order[i]);
+
+    std::vector<unsigned> columns;
+    auto addMove = [&](const person_index *p_columns, const unsigned count, const bool forward)
+    {
+        columns.clear();
+        for (unsigned t = 0; t < count; t++)                    /**< speed classes to names*/
+        {
+            std::vector<unsigned> &from = forward ? beginning[class_of[p_columns[t]]] : end[class_of[p_columns[t]]];
+            std::vector<unsigned> &to   = forward ? end[class_of[p_columns[t]]] : beginning[class_of[p_columns[t]]];
+            columns.push_back(from.back());
+            to.push_back(from.back());
+            from.pop_back();
+        }
+        std::sort(columns.begin(), columns.end());
+
+        PersonPointers move;
+        move.persons = p_of_persons;
+        for (unsigned t = 0; t < count; t++)
+        {
+            if (t == 0)
+                move.first_name = &p_of_persons[columns[t]].name;
+            else if (t == 1)
+                move.second_name = &p_of_persons[columns[t]].name;
+            else
+                move.other_persons |= std::uint64_t(1) << columns[t];
+            if (move.speed == nullptr || p_of_persons[columns[t]].speed > *move.speed)
+                move.speed = &p_of_persons[columns[t]].speed;
+        }
+        schedule.push_back(move);
+    };
+
+    for (std::size_t i = best_steps.size(); i > 0; i -= move_columns)
+    {
+        addMove(&best_steps[i - move_columns], capacity, true);
+        addMove(&best_steps[i - 1], 1, false);
+    }
+    addMove(last_move.data(), last_move.size(), true);
+
+    return schedule;
+}
+
+
+/**
+ * @brief parseNumber() function reads number of command line option or of input line
+ *
+ * Text has from 1 to 9 digits and nothing else, so number fits in unsigned and conversion does not throw.
+ *
+ * @param text digits of the number
+ * @param number reference in which number is recorded if text is valid
+ * @return true if text is valid number
+ */
+template <typename Number>
+inline bool parseNumber(const std::string &text, Number &number)
+{
+    if (text.empty() || text.size() > 9 || text.find_first_not_of("0123456789") != std::string::npos)
+        return false;
+    number = (Number) std::stoul(text);
+    return true;
+}
+
+/**
+ * @brief parseGroup() function reads one group of persons from a line without prompts
+ *
+ * Line contains pairs of name and speed separated with spaces, optionally with number of persons in front, for example
+ * "4 a 1 b 2 c 5 d 10" or "a 1 b 2 c 5 d 10".
+ *
+ * @param line text of one group
+ * @param persons vector in which persons are recorded
+ * @return true if line is valid group
+ */
+inline bool parseGroup(const std::string &line, std::vector<PersonInformation> &persons)
+{
+    std::istringstream in(line);
+    std::vector<std::string> tokens;
+    for (std::string token; in >> token; )
+        tokens.push_back(token);
+
+    std::size_t first = 0;
+    if (tokens.size() % 2 == 1)                                /**< number of persons in front*/
+    {
+        if (tokens[0].size() > 9 || tokens[0].find_first_not_of("0123456789") != std::string::npos ||
+            std::stoul(tokens[0]) != tokens.size() / 2)
+            return false;
+        first = 1;
+    }
+
+    persons.clear();
+    for (std::size_t i = first; i < tokens.size(); i += 2)
+    {
+        const std::string &speed = tokens[i + 1];
+        if (speed.empty() || speed.size() > 9 || speed.find_first_not_of("0123456789") != std::string::npos)
+            return false;
+        persons.push_back(PersonInformation{tokens[i], (unsigned) std::stoul(speed)});
+    }
+
+    return true;
+}
+
+const unsigned cache_max_persons = 32;       /**< biggest group that is kept in scheduleCache*/
+
+/**
+ * @brief Class scheduleCache keeps minimal schedules in memory mapped file, so they are shared by processes and runs.
+ *
+ * Minimal speed depends only on speeds of persons and capacity of the tunnel, not on names, so key of the cache is
+ * capacity and sorted speeds. Schedule is kept as masks of movers over sorted persons and on lookup it is mapped back
+ * to persons of the caller, persons with same speed can change places. File has fixed number of slots, slots are in
+ * sets of cache_ways slots and key can be only in its set, when set is full the least recently used slot is evicted.
+ * Every slot has sequence number that is odd while slot is written, so readers and writers from more processes and
+ * threads need no lock, reader that sees a change of sequence only misses the cache. Writer takes the slot with one
+ * compare and swap of sequence and its process id, so slot of a writer that died while writing is taken by next writer.
+ * File can be written by other programs, so schedule read from slot is used only if it moves persons of the group over
+ * the tunnel by rules of its capacity.
+ */
+class scheduleCache
+{
+    static const unsigned cache_ways = 8;                    /**< slots in one set*/
+    static const std::uint32_t cache_version = 2;            /**< version of layout of the file*/
+
+    /**@brief Structure which is at the beginning of the file*/
+    struct CacheHeader
+    {
+        char magic[8];                  /**< "TUNNELC" and zero*/
+        std::uint32_t version;          /**< cache_version*/
+        std::uint32_t slot_size;        /**< size of CacheSlot*/
+        std::uint64_t slots;            /**< number of slots in file*/
+        std::uint64_t clock;            /**< counter of uses, for least recently used slot*/
+    };
+
+    /**@brief Structure which contains one cached schedule*/
+    struct CacheSlot
+    {
+        std::uint64_t sequence;                        /**< low half is odd while slot is written, 0 if slot was never
+                                                            written, high half is process id of the writer while odd*/
+        std::uint16_t capacity;                        /**< capacity of the tunnel*/
+        std::uint16_t number_of_persons;               /**< persons of the group*/
+        std::uint32_t number_of_moves;                 /**< moves of the schedule*/
+        std::uint64_t hash;                            /**< hash of the key*/
+        std::uint64_t last_used;                       /**< clock of last use*/
+        std::uint32_t speeds[cache_max_persons];       /**< sorted speeds*/
+        std::uint64_t movers[2 * cache_max_persons];   /**< bit j is j-th person in sorted order*/
+    };
+
+    int m_file;                          /**< descriptor of the file, -1 if cache is not open*/
+    std::size_t m_size;                  /**< size of mapping*/
+    CacheHeader *mp_header;              /**< beginning of mapped file*/
+    CacheSlot *mp_slots;                 /**< slots after the header*/
+    std::uint64_t m_sets;                /**< number of sets of slots*/
+
+    /** @brief Function hashKey() returns FNV-1a hash of capacity and sorted speeds.*/
+    static std::uint64_t hashKey(const unsigned capacity, const std::vector<unsigned> &speeds)
+    {
+        std::uint64_t hash = 14695981039346656037ULL;
+        auto mix = [&hash](std::uint32_t value)
+        {
+            for (unsigned i = 0; i < 4; i++, value >>= 8)
+                hash = (hash ^ (value & 0xFF)) * 1099511628211ULL;
+        };
+
+        mix(capacity);
+        mix(speeds.size());
+        for (unsigned speed : speeds)
+            mix(speed);
+        return hash;
+    }
+
+    /** @brief Function matches() returns true if slot copy has key of capacity and speeds.*/
+    static bool matches(const CacheSlot &slot, const std::uint64_t hash, const unsigned capacity, const std::vector<unsigned> &speeds)
+    {
+        return slot.hash == hash && slot.capacity == capacity && slot.number_of_persons == speeds.size() &&
+               std::equal(speeds.begin(), speeds.end(), slot.speeds);
+    }
+
+    /** @brief Function validMovers() returns true if moves of slot copy take all its persons over the tunnel.*/
+    static bool validMovers(const CacheSlot &copy)
+    {
+        if (copy.number_of_persons < 2 || copy.number_of_persons > cache_max_persons || copy.capacity < 2 ||
+            copy.number_of_moves == 0 || copy.number_of_moves > 2 * cache_max_persons)
+            return false;
+
+        const std::uint64_t all_persons = (std::uint64_t(1) << copy.number_of_persons) - 1;
+        std::uint64_t beginning = all_persons;
+        for (unsigned i = 0; i < copy.number_of_moves; i++)
+        {
+            const std::uint64_t movers = copy.movers[i];
+            const bool forward = i % 2 == 0;
+            if (movers == 0 || (movers & ~(forward ? beginning : all_persons & ~beginning)) != 0 ||
+                (unsigned) __builtin_popcountll(movers) > (forward ? copy.capacity : 1))
+                return false;
+            beginning ^= movers;
+        }
+        return beginning == 0;
+    }
+
+    /** @brief Function writing() returns true if sequence is of slot that is written.*/
+    static bool writing(const std::uint64_t sequence) { return sequence & 1; }
+
+    /** @brief Function abandoned() returns true if sequence is of slot whose writer process does not exist anymore.*/
+    static bool abandoned(const std::uint64_t sequence)
+    {
+        const pid_t owner = (pid_t) (sequence >> 32);         /**< writers always record their id, 0 only in broken file*/
+        return writing(sequence) && (owner <= 0 || (::kill(owner, 0) != 0 && errno == ESRCH));
+    }
+
+    /** @brief Function readSlot() copies slot, returns false if slot is written at same time.*/
+    static bool readSlot(const CacheSlot &slot, CacheSlot &copy)
+    {
+        const std::uint64_t sequence = __atomic_load_n(&slot.sequence, __ATOMIC_ACQUIRE);
+        if (sequence == 0 || writing(sequence))
+            return false;
+
+        std::memcpy(static_cast<void*>(&copy), &slot, sizeof(CacheSlot));
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        return __atomic_load_n(&slot.sequence, __ATOMIC_RELAXED) == sequence;
+    }
+
+public:
+
+    /**
+     * @brief Constructor of a class opens or creates cache file and maps it.
+     *
+     * File that does not exist or has other layout is made again with number_of_slots slots, existing file keeps its
+     * number of slots. Initialization is done under file lock, so processes that start together make file once.
+     * Without path cache is in anonymous memory of this process only.
+     *
+     * @param path path of the cache file, empty for cache without file
+     * @param number_of_slots number of slots of new file, rounded up to whole sets
+     */
+    scheduleCache(const std::string &path, std::uint64_t number_of_slots)
+    : m_file(-1), m_size(0), mp_header(nullptr), mp_slots(nullptr), m_sets(0)
+    {
+        number_of_slots = (number_of_slots + cache_ways - 1) / cache_ways * cache_ways;
+        if (number_of_slots == 0)
+            number_of_slots = cache_ways;
+
+        if (path.empty())
+        {
+            m_size = sizeof(CacheHeader) + number_of_slots * sizeof(CacheSlot);
+            void *p_memory = ::mmap(nullptr, m_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+            if (p_memory == MAP_FAILED)
+                return;
+
+            mp_header = static_cast<CacheHeader*>(p_memory);                  /**< anonymous memory is zeroed*/
+            mp_slots  = reinterpret_cast<CacheSlot*>(static_cast<char*>(p_memory) + sizeof(CacheHeader));
+            m_sets    = number_of_slots / cache_ways;
+            std::memcpy(mp_header->magic, "TUNNELC", 8);
+            mp_header->version   = cache_version;
+            mp_header->slot_size = sizeof(CacheSlot);
+            mp_header->slots     = number_of_slots;
+            return;
+        }
+
+        int file = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+        if (file < 0)
+            return;
+        ::flock(file, LOCK_EX);
+
+        CacheHeader header;
+        struct stat file_stat;
+        bool valid = ::fstat(file, &file_stat) == 0 && (std::size_t) file_stat.st_size >= sizeof(CacheHeader) &&
+                     ::pread(file, &header, sizeof(CacheHeader), 0) == (ssize_t) sizeof(CacheHeader) &&
+                     std::memcmp(header.magic, "TUNNELC", 8) == 0 && header.version == cache_version &&
+                     header.slot_size == sizeof(CacheSlot) && header.slots > 0 && header.slots % cache_ways == 0 &&
+                     (std::size_t) file_stat.st_size == sizeof(CacheHeader) + header.slots * sizeof(CacheSlot);
+
+        if (!valid)                                              /**< new file or file of other layout*/
+        {
+            std::memset(&header, 0, sizeof(CacheHeader));
+            std::memcpy(header.magic, "TUNNELC", 8);
+            header.version   = cache_version;
+            header.slot_size = sizeof(CacheSlot);
+            header.slots     = number_of_slots;
+
+            valid = ::ftruncate(file, 0) == 0 &&
+                    ::ftruncate(file, sizeof(CacheHeader) + number_of_slots * sizeof(CacheSlot)) == 0 &&
+                    ::pwrite(file, &header, sizeof(CacheHeader), 0) == (ssize_t) sizeof(CacheHeader);
+        }
+
+        if (valid)
+        {
+            m_size = sizeof(CacheHeader) + header.slots * sizeof(CacheSlot);
+            void *p_memory = ::mmap(nullptr, m_size, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+            if (p_memory != MAP_FAILED)
+            {
+                mp_header = static_cast<CacheHeader*>(p_memory);
+                mp_slots  = reinterpret_cast<CacheSlot*>(static_cast<char*>(p_memory) + sizeof(CacheHeader));
+                m_sets    = header.slots / cache_ways;
+            }
+        }
+
+        ::flock(file, LOCK_UN);
+        if (mp_header == nullptr)
+        {
+            ::close(file);
+            return;
+        }
+        m_file = file;
+    }
+
+    /** @brief Destructor of a class unmaps and closes the file.*/
+    ~scheduleCache()
+    {
+        if (mp_header != nullptr)
+            ::munmap(mp_header, m_size);
+        if (m_file >= 0)
+            ::close(m_file);
+    }
+
+    scheduleCache(const scheduleCache&) = delete;
+    scheduleCache& operator= (const scheduleCache&) = delete;
+
+    /** @brief Function isOpen() returns true if file is mapped.*/
+    bool isOpen() const { return mp_header != nullptr; }
+
+    /** @brief Function slots() returns number of slots in the file.*/
+    std::uint64_t slots() const { return m_sets * cache_ways; }
+
+    /**
+     * @brief Function find() looks for schedule of sorted speeds and capacity.
+     *
+     * @param capacity capacity of the tunnel
+     * @param speeds sorted speeds of the group
+     * @param movers vector in which masks of movers over sorted persons are recorded
+     * @return true if schedule is found
+     */
+    bool find(const unsigned capacity, const std::vector<unsigned> &speeds, std::vector<std::uint64_t> &movers)
+    {
+        if (!isOpen() || speeds.size() > cache_max_persons)
+            return false;
+
+        const std::uint64_t hash = hashKey(capacity, speeds);
+        CacheSlot *p_set = mp_slots + (hash % m_sets) * cache_ways;
+        CacheSlot copy;
+
+        for (unsigned w = 0; w < cache_ways; w++)
+            if (readSlot(p_set[w], copy) && matches(copy, hash, capacity, speeds) && validMovers(copy))
+            {
+                movers.assign(copy.movers, copy.movers + copy.number_of_moves);
+                __atomic_store_n(&p_set[w].last_used, __atomic_add_fetch(&mp_header->clock, 1, __ATOMIC_RELAXED), __ATOMIC_RELAXED);
+                stats().add(solverStats::counter_cache_hits, 1);
+                return true;
+            }
+
+        stats().add(solverStats::counter_cache_misses, 1);
+        return false;
+    }
+
+    /**
+     * @brief Function store() records schedule of sorted speeds and capacity in its set.
+     *
+     * Slot with same key, empty slot, slot of writer that died or the least recently used slot is written. If the slot
+     * is written by other process or thread at same time, schedule is not recorded.
+     *
+     * @param capacity capacity of the tunnel
+     * @param speeds sorted speeds of the group
+     * @param movers masks of movers over sorted persons
+     */
+    void store(const unsigned capacity, const std::vector<unsigned> &speeds, const std::vector<std::uint64_t> &movers)
+    {
+        if (!isOpen() || speeds.size() > cache_max_persons || movers.size() > 2 * cache_max_persons)
+            return;
+
+        const std::uint64_t hash = hashKey(capacity, speeds);
+        CacheSlot *p_set = mp_slots + (hash % m_sets) * cache_ways;
+        CacheSlot copy;
+
+        unsigned victim = 0;
+        std::uint64_t oldest = ~std::uint64_t(0);
+        for (unsigned w = 0; w < cache_ways; w++)
+        {
+            if (readSlot(p_set[w], copy) && matches(copy, hash, capacity, speeds))
+            {
+                if (validMovers(copy))
+                    return;                                       /**< stored by other process*/
+                victim = w;                                       /**< broken schedule of same key is written again*/
+                break;
+            }
+            const std::uint64_t sequence = __atomic_load_n(&p_set[w].sequence, __ATOMIC_RELAXED);
+            const std::uint64_t last_used = sequence == 0 || abandoned(sequence)
+                                          ? 0 : __atomic_load_n(&p_set[w].last_used, __ATOMIC_RELAXED);
+            if (last_used < oldest)
+            {
+                oldest = last_used;
+                victim = w;
+            }
+        }
+
+        CacheSlot &slot = p_set[victim];
+        std::uint64_t sequence = __atomic_load_n(&slot.sequence, __ATOMIC_RELAXED);
+        if (writing(sequence) && !abandoned(sequence))
+            return;
+        const std::uint32_t count = (std::uint32_t) sequence + (writing(sequence) ? 2 : 1);     /**< odd, slot is written*/
+        const std::uint64_t owner = (std::uint64_t) (std::uint32_t) ::getpid() << 32;
+        if (!__atomic_compare_exchange_n(&slot.sequence, &sequence, owner | count, false, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED))
+            return;
+        __atomic_thread_fence(__ATOMIC_RELEASE);                  /**< odd sequence is seen before any payload*/
+        if (sequence != 0)
+            stats().add(solverStats::counter_cache_evictions, 1);
+
+        slot.capacity          = capacity;
+        slot.number_of_persons = speeds.size();
+        slot.hash              = hash;
+        slot.number_of_moves   = movers.size();
+        std::copy(speeds.begin(), speeds.end(), slot.speeds);
+        std::copy(movers.begin(), movers.end(), slot.movers);
+        __atomic_store_n(&slot.last_used, __atomic_add_fetch(&mp_header->clock, 1, __ATOMIC_RELAXED), __ATOMIC_RELAXED);
+
+        __atomic_store_n(&slot.sequence, (std::uint64_t) (std::uint32_t) (count + 1), __ATOMIC_RELEASE);
+    }
+};
+
+
+/**@brief Structure which contains settings of the solver that are same for every group*/
+struct SolverSettings
+{
+    std::string solver = "enumerate";   /**< enumerate - all paths of generator chain, dijkstra - shortest path over states,
+                                             fast - closed form over sorted speeds, classes - shortest path over speed classes,
+                                             fixed - compile time solvers for 2 to 16 persons, bound - branch and bound
+                                             search over generator chain, large - rounds of masks of any width*/
+    unsigned capacity = 2;              /**< number of persons that tunnel carries at once, at least two*/
+    scheduleCache *cache = nullptr;     /**< cache of minimal schedules, nullptr - no cache*/
+    OutputFormat format = format_text;  /**< format of schedules of batch and server*/
+    std::string spill_file;             /**< prefix of files for steps of large solver, empty - steps in memory*/
+    bool count = false;                 /**< numbers of paths of generator chain instead of schedule*/
+    bool server_limits = false;         /**< groups are limited by serverLimit(), so one request of server
+                                             cannot take all memory and time*/
+};
+
+const unsigned server_chain_persons = 16;     /**< biggest group of server for count and bound, chain has 2^n rows*/
+const unsigned server_enumerate_persons = 7;  /**< biggest group of server for enumerate, paths grow faster than n!*/
+const unsigned server_state_persons = 18;     /**< biggest group of server for dijkstra and fixed, 2^n states, and
+                                                   2^n states of speed classes for classes*/
+const unsigned server_large_persons = 64;     /**< biggest group of server for large with capacity above two*/
+const unsigned server_large_classes = 8;      /**< most speed classes of server for large with capacity above two, 63
+                                                   persons of 8 classes take less than 0.1 s for capacity 3 to 5*/
+const std::size_t server_max_request = 65536; /**< longest request line of server in bytes*/
+const std::size_t server_max_queued = 1024;   /**< requests of connection that wait for job, more are not read*/
+const std::size_t server_max_answers = 1 << 20;  /**< bytes of answers of connection that client did not read, more
+                                                      requests are not read*/
+
+/**
+ * @brief serverLimit() function returns true if group is small enough for solver of server
+ *
+ * Solvers of generator chain grow with rows and paths of the chain, dijkstra and fixed with states of persons, classes
+ * with states of speed classes and large with speed classes and capacity. Fast and large solvers with capacity two need
+ * no limit, solveGroup() solves both with fastPath(), large solver itself takes seconds for 64 persons of different speeds.
+ * Limits keep one request under few seconds and its memory far from what out of memory killer ends.
+ *
+ * @param persons persons of the group
+ * @param settings solver and capacity of the tunnel
+ * @return true if server solves the group
+ */
+inline bool serverLimit(const std::vector<PersonInformation> &persons, const SolverSettings &settings)
+{
+    std::vector<unsigned> speeds;
+    for (auto &person : persons)
+        speeds.push_back(person.speed);
+    std::sort(speeds.begin(), speeds.end());
+
+    unsigned classes = 0;                                   /**< number of speed classes*/
+    std::uint64_t class_states = 1;                         /**< product of class sizes plus one, saturated*/
+    for (std::size_t first = 0, last = 0; first < speeds.size(); first = last)
+    {
+        while (last < speeds.size() && speeds[last] == speeds[first])
+            ++last;
+        ++classes;
+        class_states = std::min<std::uint64_t>(class_states * (last - first + 1), std::uint64_t(1) << 32);
+    }
+
+    if (settings.count || settings.solver == "bound")
+        return persons.size() <= server_chain_persons;
+    if (settings.solver == "enumerate")
+        return persons.size() <= server_enumerate_persons;
+    if (settings.solver == "classes")
+        return class_states <= (std::uint64_t(1) << server_state_persons);
+    if ((settings.solver == "fast" || settings.solver == "large") && settings.capacity == 2)
+        return true;
+    if (settings.solver == "large")
+        return persons.size() <= server_large_persons && classes <= server_large_classes;
+    return persons.size() <= server_state_persons;          /**< dijkstra, fixed and fast with bigger capacity*/
+}
+
+/** @brief Function threadArena() returns arena of calling thread, chains of groups of batch and server take it one after other.*/
+inline edgeArena& threadArena()
+{
+    thread_local edgeArena arena;
+    return arena;
+}
+
+/**
+ * @brief solveGroup() function solves one group with chosen solver and returns minimal schedule
+ *
+ * Fast solver is only for tunnel that carries two persons, for bigger capacity Dijkstra solver is used instead. Large
+ * groups of tunnel that carries two persons are also solved with fast solver, largePath() takes seconds for 64 persons.
+ * With cache, group is first looked up by its sorted speeds and schedule from cache is mapped on its persons, so no
+ * generators are made for repeated speeds, solved schedule is recorded in cache. Generator chain takes memory from
+ * threadArena(), so groups that one thread solves one after other reuse its blocks.
+ *
+ * @param p_of_persons pointer to array of structure PersonInformation
+ * @param number_of_persons number of persons in array, at least two
+ * @param settings solver and capacity of the tunnel
+ * @return moves of one minimal schedule, empty if large solver cannot use spill file or write a move
+ */
+inline std::vector<PersonPointers> solveGroup(PersonInformation *p_of_persons, const unsigned number_of_persons,
+                                              const SolverSettings &settings)
+{
+    std::vector<PersonPointers> schedule;
+    std::vector<unsigned> order(number_of_persons);        /**< columns of persons sorted by speed*/
+    std::vector<unsigned> speeds(number_of_persons);       /**< sorted speeds, key of cache*/
+    std::vector<std::uint64_t> movers;                     /**< moves over sorted persons*/
+    const bool cached = settings.cache != nullptr && number_of_persons <= cache_max_persons;
+
+    if (cached)
+    {
+        for (unsigned i = 0; i < number_of_persons; i++)
+            order[i] = i;
+        std::stable_sort(order.begin(), order.end(), [p_of_persons](unsigned a, unsigned b)
+                         { return p_of_persons[a].speed < p_of_persons[b].speed; });
+        for (unsigned i = 0; i < number_of_persons; i++)
+            speeds[i] = p_of_persons[order[i]].speed;
+
+        if (settings.cache->find(settings.capacity, speeds, movers))
+        {
+            for (std::uint64_t sorted_movers : movers)         /**< sorted persons to persons of the group*/
+            {
+                std::uint64_t columns = 0;
+                for (; sorted_movers != 0; sorted_movers &= sorted_movers - 1)
+                    columns |= std::uint64_t(1) << order[__builtin_ctzll(sorted_movers)];
+                schedule.push_back(movePersons(p_of_persons, columns));
+            }
+            return schedule;
+        }
+    }
+
+    if ((settings.solver == "fast" || settings.solver == "large") && settings.capacity == 2)
+        schedule = fastPath(p_of_persons, number_of_persons);          /**< closed form is minimal for any group*/
+    else if (settings.solver == "fixed")
+        schedule = fixedPath(p_of_persons, number_of_persons, settings.capacity);
+    else if (settings.solver == "large")
+        schedule = largePath(p_of_persons, number_of_persons, settings.capacity, settings.spill_file);
+    else if (settings.solver == "bound")
+    {
+        generatorChain chain(p_of_persons, number_of_persons, 1, settings.capacity, &threadArena());
+        schedule = boundPath(chain.start(), p_of_persons, number_of_persons, settings.capacity);
+    }
+    else if (settings.solver == "classes")
+        schedule = classPath(p_of_persons, number_of_persons, settings.capacity);
+    else if (settings.solver == "dijkstra" || settings.solver == "fast")
+        schedule = shortestPath(p_of_persons, number_of_persons, settings.capacity);
+    else
+    {
+        generatorChain chain(p_of_persons, number_of_persons, 1, settings.capacity, &threadArena());
+        pathEnumerator paths(chain.start());
+        schedule = minimumPath(paths);
+    }
+
+    if (cached && !schedule.empty())
+    {
+        std::vector<unsigned> sorted_position(number_of_persons);
+        for (unsigned i = 0; i < number_of_persons; i++)
+            sorted_position[order[i]] = i;
+
+        movers.clear();
+        for (auto &move : schedule)
+        {
+            std::uint64_t sorted_movers = 0;
+            for (std::uint64_t columns = moveColumns(move, p_of_persons, number_of_persons); columns != 0; columns &= columns - 1)
+                sorted_movers |= std::uint64_t(1) << sorted_position[__builtin_ctzll(columns)];
+            movers.push_back(sorted_movers);
+        }
+        settings.cache->store(settings.capacity, speeds, movers);
+    }
+
+    return schedule;
+}
+
+/**
+ * @brief selfCheck() function compares fast, Dijkstra, class, fixed, branch and bound and large solvers against enumeration of all paths on random small groups
+ *
+ * Groups have from 2 to 6 persons with speeds from 1 to 20 and tunnel carries from 2 to 4 persons, random generator has
+ * fixed seed so every run checks same groups. Fast solver is checked only for capacity two. Vector kernels of
+ * matchRowsKernel() that processor supports are compared with scalar kernel on random rows of the group, countPaths()
+ * is compared with number of all paths and of the quickest paths of enumeration. Minimum, top-K and ordered paths
+ * of parallel enumeration on three threads are compared with one pathEnumerator. For capacity three schedule of large
+ * solver is stored in scheduleCache and read back, both must be valid and minimal. For capacity two incrementalSolver
+ * of the group is checked after speed change, add and remove. Fixed solver is also checked on one group of 9-digit speeds
+ * whose totals do not fit in 32 bits. Every mismatch is printed on std::cerr.
+ *
+ * @param number_of_groups number of random groups to check
+ * @return number of groups in which solvers do not agree
+ */
+inline unsigned selfCheck(const unsigned number_of_groups)
+{
+    std::mt19937 random_generator(2017);
+    std::uniform_int_distribution<unsigned> random_size(2, 6);
+    std::uniform_int_distribution<unsigned> random_speed(1, 20);
+    std::uniform_int_distribution<unsigned> random_capacity(2, 4);
+    const matchRowsFunction kernels[] = {matchRowsKernel("sse4.2"), matchRowsKernel("avx2")};
+    scheduleCache cache(std::string(), 4096);                      /**< schedules in memory for large solver*/
+    unsigned mismatches = 0;
+
+    {                                                               /**< other schedules of the group wrap in 32 bits*/
+        std::vector<PersonInformation> persons{{"a", 1}, {"b", 999999999}, {"c", 999999999}, {"d", 999999999}, {"e", 999999999}};
+        const unsigned long long fixed_speed = scheduleSpeed(fixedPath(persons.data(), persons.size()));
+        if (fixed_speed != 3999999999ULL)
+        {
+            ++mismatches;
+            std::cerr << "mismatch in group of 9-digit speeds: fixed " << fixed_speed << " expected 3999999999\n";
+        }
+    }
+
+    for (unsigned group = 0; group < number_of_groups; group++)
+    {
+        std::vector<PersonInformation> persons(random_size(random_generator));
+        for (unsigned i = 0; i < persons.size(); i++)
+        {
+            persons[i].name  = "p" + std::to_string(i);
+            persons[i].speed = random_speed(random_generator);
+        }
+
+        const unsigned capacity = random_capacity(random_generator);
+
+        generatorChain chain(persons.data(), persons.size(), 1, capacity);
+        pathEnumerator paths(chain.start());
+        unsigned long long enumerate_speed = scheduleSpeed(minimumPath(paths));
+        unsigned long long bound_speed     = scheduleSpeed(boundPath(chain.start(), persons.data(), persons.size(), capacity));
+        unsigned long long dijkstra_speed  = scheduleSpeed(shortestPath(persons.data(), persons.size(), capacity));
+        unsigned long long fast_speed      = capacity == 2 ? scheduleSpeed(fastPath(persons.data(), persons.size())) : dijkstra_speed;
+        unsigned long long classes_speed   = scheduleSpeed(classPath(persons.data(), persons.size(), capacity));
+        unsigned long long fixed_speed     = scheduleSpeed(fixedPath(persons.data(), persons.size(), capacity));
+        unsigned long long large_speed     = scheduleSpeed(largePath(persons.data(), persons.size(), capacity));
+
+        if (enumerate_speed != dijkstra_speed || enumerate_speed != fast_speed || enumerate_speed != classes_speed ||
+            enumerate_speed != fixed_speed || enumerate_speed != bound_speed || enumerate_speed != large_speed)
+        {
+            ++mismatches;
+            std::cerr << "mismatch in group " << group << ":";
+            for (auto &person : persons)
+                std::cerr << " " << person.name << " " << person.speed;
+            std::cerr << " capacity " << capacity << " enumerate " << enumerate_speed << " dijkstra " << dijkstra_speed
+                      << " fast " << fast_speed << " classes " << classes_speed << " fixed " << fixed_speed
+                      << " bound " << bound_speed << " large " << large_speed << "\n";
+        }
+
+        if (capacity == 3)                                          /**< large schedule stored in cache and read back*/
+        {
+            auto valid = [&](const std::vector<PersonPointers> &schedule)
+            {
+                state_word beginning = (state_word(1) << persons.size()) - 1;
+                bool forward = true;
+                for (auto &move : schedule)
+                {
+                    const state_word movers = moveColumns(move, persons.data(), persons.size());
+                    if (movers == 0 || (movers & (forward ? ~beginning : beginning)) != 0 ||
+                        (unsigned) __builtin_popcountll(movers) > (forward ? capacity : 1))
+                        return false;
+                    beginning ^= movers;
+                    forward = !forward;
+                }
+                return beginning == 0;
+            };
+
+            SolverSettings settings;
+            settings.solver   = "large";
+            settings.capacity = capacity;
+            settings.cache    = &cache;
+            std::vector<PersonPointers> solved = solveGroup(persons.data(), persons.size(), settings);
+            std::vector<PersonPointers> cached = solveGroup(persons.data(), persons.size(), settings);
+            if (!valid(solved) || !valid(cached) || scheduleSpeed(solved) != enumerate_speed ||
+                scheduleSpeed(cached) != enumerate_speed)
+            {
+                ++mismatches;
+                std::cerr << "mismatch in group " << group << ": large schedule from cache " << scheduleSpeed(cached)
+                          << " solved " << scheduleSpeed(solved) << "\n";
+            }
+        }
+
+        pathEnumerator all_paths(chain.start());
+        unsigned long long number_of_paths = 0, number_of_minimal_paths = 0;
+        while (all_paths.next() != nullptr)
+        {
+            ++number_of_paths;
+            number_of_minimal_paths += all_paths.speed() == enumerate_speed;
+        }
+        PathCounts counts = countPaths(chain.start());
+        if (counts.paths != bigCounter(number_of_paths) || counts.minimal_paths != bigCounter(number_of_minimal_paths) ||
+            counts.speed != enumerate_speed)
+        {
+            ++mismatches;
+            std::cerr << "mismatch in group " << group << ": counts of paths " << counts.paths.toString() << " "
+                      << counts.minimal_paths.toString() << " enumeration " << number_of_paths << " "
+                      << number_of_minimal_paths << "\n";
+        }
+
+        {                                                           /**< parallel modes against one pathEnumerator*/
+            pathEnumerator serial_paths(chain.start());
+            std::vector<RankedPath> serial = cheapestPaths(serial_paths, 5);
+            std::vector<RankedPath> parallel = parallelCheapest(chain.start(), 3, 5);
+            bool same = serial.size() == parallel.size();
+            for (std::size_t i = 0; same && i < serial.size(); i++)
+                same = serial[i].speed == parallel[i].speed && serial[i].path == parallel[i].path;
+
+            pathEnumerator min_paths(chain.start());
+            std::vector<PersonPointers> serial_min = minimumPath(min_paths), parallel_min = parallelMinimum(chain.start(), 3);
+            same = same && serial_min.size() == parallel_min.size();
+            for (std::size_t i = 0; same && i < serial_min.size(); i++)
+                same = serial_min[i].persons == parallel_min[i].persons && serial_min[i].speed == parallel_min[i].speed &&
+                       serial_min[i].first_name == parallel_min[i].first_name &&
+                       serial_min[i].second_name == parallel_min[i].second_name &&
+                       serial_min[i].other_persons == parallel_min[i].other_persons;
+
+            pathEnumerator ordered_paths(chain.start());
+            parallelEnumerator streamed_paths(chain.start(), 3);
+            for (;;)
+            {
+                const vector_of_persons *p_ordered = ordered_paths.next(), *p_streamed = streamed_paths.next();
+                if (p_ordered == nullptr || p_streamed == nullptr)
+                {
+                    same = same && p_ordered == p_streamed;
+                    break;
+                }
+                same = same && *p_ordered == *p_streamed && ordered_paths.speed() == streamed_paths.speed();
+            }
+
+            if (!same)
+            {
+                ++mismatches;
+                std::cerr << "mismatch in group " << group << ": parallel paths do not match one enumerator\n";
+            }
+        }
+
+        const state_word all_columns = (state_word(1) << persons.size()) - 1;
+        std::vector<unsigned> speeds;
+        for (auto &person : persons)
+            speeds.push_back(person.speed);
+
+        state_word rows[rowMatches::block_rows - 1];                /**< odd block, so kernels also match a tail*/
+        const state_word source = random_generator() & all_columns;
+        for (state_word &row : rows)
+            row = (~source | random_generator()) & all_columns;
+
+        rowMatches expected, matches;
+        matchRowsScalar(source, rows, rowMatches::block_rows - 1, all_columns, speeds.data(), expected);
+        for (matchRowsFunction kernel : kernels)
+        {
+            if (kernel == nullptr)
+                continue;
+
+            kernel(source, rows, rowMatches::block_rows - 1, all_columns, speeds.data(), matches);
+            bool same = matches.bitmap == expected.bitmap;
+            for (std::uint64_t bits = expected.bitmap; bits != 0; bits &= bits - 1)
+            {
+                const unsigned k = __builtin_ctzll(bits);
+                same = same && matches.movers[k] == expected.movers[k] && matches.speed[k] == expected.speed[k];
+            }
+            if (!same)
+            {
+                ++mismatches;
+                std::cerr << "mismatch in group " << group << ": vector kernel does not match scalar kernel\n";
+            }
+        }
+
+        if (capacity == 2)                                          /**< edits of incrementalSolver against Dijkstra*/
+        {
+            incrementalSolver incremental(persons.data(), persons.size(), 1);
+            bool same = incremental.speed() == enumerate_speed && scheduleSpeed(incremental.schedule()) == enumerate_speed;
+
+            persons[0].speed = random_speed(random_generator);
+            incremental.setSpeed(0, persons[0].speed);
+            same = same && incremental.speed() == scheduleSpeed(shortestPath(persons.data(), persons.size()));
+
+            persons.push_back(PersonInformation{"q", random_speed(random_generator)});
+            incremental.addPerson(persons.back().name, persons.back().speed);
+            same = same && incremental.speed() == scheduleSpeed(shortestPath(persons.data(), persons.size()));
+
+            incremental.removePerson(0);
+            persons.erase(persons.begin());
+            same = same && incremental.speed() == scheduleSpeed(shortestPath(persons.data(), persons.size())) &&
+                   scheduleSpeed(incremental.schedule()) == incremental.speed();
+            if (!same)
+            {
+                ++mismatches;
+                std::cerr << "mismatch in group " << group << ": edits of incremental solver\n";
+            }
+        }
+    }
+
+    return mismatches;
+}
+
+/**
+ * @brief solveLine() function parses and solves one group of batch input
+ *
+ * @param line text of one group
+ * @param settings solver, capacity of the tunnel and output format
+ * @param answer buffer to which one line with minimal schedule, with counts of paths or with error is appended
+ * @return no return
+ */
+inline void solveLine(const std::string &line, const SolverSettings &settings, std::string &answer)
+{
+    std::vector<PersonInformation> persons;
+    stats().add(solverStats::counter_instances, 1);
+    if (!parseGroup(line, persons))
+    {
+        appendError(answer, "expected pairs of name and speed", settings.format);
+        return;
+    }
+    const bool single_word = settings.capacity > 2 ||
+                             (!settings.count && (settings.solver == "dijkstra" || settings.solver == "classes" ||
+                              settings.solver == "fixed" || settings.solver == "bound"));   /**< persons of a move or state in one mask*/
+    const bool chain = settings.count || settings.solver == "enumerate" || settings.solver == "bound";  /**< generator chain*/
+    if (persons.size() < 2 || persons.size() >= no_person || (single_word && persons.size() >= state_word_bits) ||
+        (chain && persons.size() > chain_max_persons) || (settings.server_limits && !serverLimit(persons, settings)))
+    {
+        appendError(answer, "unsupported number of persons " + std::to_string(persons.size()), settings.format);
+        return;
+    }
+
+    if (settings.count)
+    {
+        generatorChain chain(persons.data(), persons.size(), 1, settings.capacity, &threadArena());
+        appendCounts(answer, countPaths(chain.start()), settings.format);
+        return;
+    }
+
+    std::vector<PersonPointers> schedule = solveGroup(persons.data(), persons.size(), settings);
+    if (schedule.empty())                                       /**< large solver cannot use spill file or write a move*/
+        appendError(answer, "no schedule for group", settings.format);
+    else
+        appendSchedule(answer, schedule, settings.format);
+}
+
+/**
+ * @brief skippedLine() function returns true for empty line or comment of batch and edits input
+ *
+ * @param line one line of input
+ * @return true if line has only spaces or its first character that is not space is '#'
+ */
+inline bool skippedLine(const std::string &line)
+{
+    const std::size_t first = line.find_first_not_of(" \t\r");
+    return first == std::string::npos || line[first] == '#';
+}
+
+/**
+ * @brief runBatch() function solves many groups, one group per line, on number of threads
+ *
+ * Lines are read in chunks, every chunk is solved by worker threads that take next line from shared atomic index, and
+ * results are written in input order when the chunk is done. Results of lines keep their buffers from chunk to chunk
+ * and are copied to one output buffer that is written with one write for every chunk. Empty lines and lines starting
+ * with '#' are skipped. Line whose solver throws, for example out of memory, is answered with error.
+ *
+ * @param in stream with groups
+ * @param out stream in which schedules are written
+ * @param settings solver, capacity of the tunnel and output format
+ * @param number_of_threads number of worker threads
+ * @return number of solved groups
+ */
+inline std::size_t runBatch(std::istream &in, std::ostream &out, const SolverSettings &settings, unsigned number_of_threads)
+{
+    stageTimer timer(solverStats::stage_batch);
+    const std::size_t chunk_size = 4096;                 /**< lines that are read before solving*/
+    std::vector<std::string> lines;
+    std::vector<std::string> results;
+    std::string output;                                  /**< answers of one chunk*/
+    std::size_t solved = 0;
+
+    if (number_of_threads == 0)
+        number_of_threads = 1;
+
+    for (bool more = true; more; )
+    {
+        lines.clear();
+        for (std::string line; lines.size() < chunk_size; )
+        {
+            if (!std::getline(in, line))
+            {
+                more = false;
+                break;
+            }
+            if (skippedLine(line))
+                continue;
+            lines.push_back(line);
+        }
+
+        results.resize(lines.size());
+        for (auto &result : results)
+            result.clear();
+        std::atomic<std::size_t> next_line(0);
+
+        auto worker = [&]()
+        {
+            for (std::size_t i = next_line++; i < lines.size(); i = next_line++)
+            {
+                try
+                {
+                    solveLine(lines[i], settings, results[i]);
+                }
+                catch (const std::exception &)              /**< out of memory fails only this line*/
+                {
+                    results[i].clear();
+                    appendError(results[i], "cannot solve group", settings.format);
+                }
+            }
+        };
+
+        std::vector<std::thread> threads;
+        for (unsigned t = 1; t < number_of_threads && t < lines.size(); t++)
+            threads.emplace_back(worker);
+        worker();
+        for (auto &thread : threads)
+            thread.join();
+
+        std::size_t output_size = 0;
+        for (auto &result : results)
+            output_size += result.size();
+        output.clear();
+        output.reserve(output_size);
+        for (auto &result : results)
+            output += result;
+        out.write(output.data(), output.size());
+        solved += lines.size();
+    }
+
+    out.flush();
+    return solved;
+}
+
+/**
+ * @brief runEdits() function solves groups that change by edits, one group or edit per line
+ *
+ * Line with pairs of name and speed starts new group, line "+ name speed" adds person, "- name" removes person and
+ * "= name speed" changes speed of person. After every line minimal schedule of the group is written. Groups are kept in
+ * incrementalSolver, so edit computes only rows whose speed changes, tunnel carries two persons and group has at most
+ * incremental_max_persons persons. Empty lines and lines starting with '#' are skipped.
+ *
+ * @param in stream with groups and edits
+ * @param out stream in which schedules are written
+ * @param format format of schedules
+ */
+inline void runEdits(std::istream &in, std::ostream &out, const OutputFormat format = format_text)
+{
+    std::unique_ptr<incrementalSolver> solver;
+    std::vector<PersonInformation> persons;
+    std::string answer;
+
+    for (std::string line; std::getline(in, line); )
+    {
+        if (skippedLine(line))
+            continue;
+
+        answer.clear();
+        std::istringstream edit(line);
+        std::string operation, name, speed;
+        edit >> operation >> name >> speed;
+        const bool speed_valid = !speed.empty() && speed.size() <= 9 && speed.find_first_not_of("0123456789") == std::string::npos;
+
+        if (operation != "+" && operation != "-" && operation != "=")
+        {
+            stats().add(solverStats::counter_instances, 1);
+            solver.reset();
+            if (!parseGroup(line, persons))
+                appendError(answer, "expected pairs of name and speed", format);
+            else if (persons.size() < 2 || persons.size() > incremental_max_persons)
+                appendError(answer, "unsupported number of persons " + std::to_string(persons.size()), format);
+            else
+                solver.reset(new incrementalSolver(persons.data(), persons.size()));
+        }
+        else if (solver == nullptr)
+            appendError(answer, "edit without group", format);
+        else if (operation == "+")
+        {
+            if (!speed_valid || solver->findPerson(name) != no_person)
+                appendError(answer, "expected new name and speed", format);
+            else if (solver->addPerson(name, std::stoul(speed)) == no_person)
+                appendError(answer, "unsupported number of persons " + std::to_string(solver->persons() + 1), format);
+        }
+        else if (solver->findPerson(name) == no_person)
+            appendError(answer, "unknown person " + name, format);
+        else if (operation == "=")
+        {
+            if (!speed_valid)
+                appendError(answer, "expected name and speed", format);
+            else
+                solver->setSpeed(solver->findPerson(name), std::stoul(speed));
+        }
+        else if (!solver->removePerson(solver->findPerson(name)))
+            appendError(answer, "group needs two persons", format);
+
+        if (answer.empty())
+            appendSchedule(answer, solver->schedule(), format);
+        out << answer;
+    }
+    out.flush();
+}
+
+
+/**
+ * @brief Class solverServer answers solve requests of clients on Unix domain socket or on standard input and output.
+ *
+ * Request is one line with group, same as line of batch, and answer is one line with minimal schedule or error, line
+ * "stats" is answered with stats in JSON. One thread polls all connections, reads requests and writes answers, and
+ * worker threads solve. All complete requests that came on a connection are solved as one job by one worker and their
+ * answers are written together, so pipelined requests are batched and answers stay in order of requests. Workers,
+ * settings and cache of schedules live as long as the server, so requests use warm cache and no threads are started
+ * per request. Latency from reading of request to its answer is added to stats. Groups are limited by serverLimit()
+ * for every solver, and request whose solver throws, for example out of memory, is answered with error while server
+ * keeps serving.
+ */
+class solverServer
+{
+    using time_point = std::chrono::steady_clock::time_point;
+
+    /**@brief Structure which contains state of one client*/
+    struct Connection
+    {
+        int input;                          /**< descriptor from which requests are read*/
+        int output;                         /**< descriptor to which answers are written*/
+        bool socket;                        /**< connection is socket, else standard input and output*/
+        bool busy;                          /**< job of the connection is solved by worker*/
+        bool end_of_input;                  /**< client sends no more requests*/
+        bool overlong;                      /**< request line is longer than server_max_request, connection ends*/
+        std::string received;               /**< read bytes after last complete request*/
+        std::vector<std::string> requests;  /**< complete requests waiting for job*/
+        std::vector<time_point> arrivals;   /**< times when requests were read*/
+        std::string answers;                /**< answers that are not written yet*/
+    };
+
+    /**@brief Structure which contains requests of one connection solved by one worker*/
+    struct Job
+    {
+        unsigned connection;                /**< identifier of the connection*/
+        std::vector<std::string> requests;  /**< requests in order*/
+        std::vector<time_point> arrivals;   /**< times when requests were read*/
+        std::string answers;                /**< answers of all requests*/
+    };
+
+    const SolverSettings &m_settings;                     /**< solver, capacity and cache*/
+    std::mutex m_lock;                                    /**< lock for jobs, solved jobs and m_stopping*/
+    std::condition_variable m_jobs_ready;                 /**< wakes workers*/
+    std::deque<Job> m_jobs;                               /**< jobs waiting for worker*/
+    std::vector<Job> m_solved;                            /**< solved jobs waiting for poll thread*/
+    bool m_stopping;                                      /**< workers end*/
+    int m_wake[2];                                        /**< pipe that wakes poll thread, 'j' solved job, 's' stop*/
+    std::vector<std::thread> m_workers;                   /**< worker threads*/
+    std::unordered_map<unsigned, Connection> m_connections;  /**< clients by identifier*/
+    unsigned m_next_connection;                           /**< identifier of next client*/
+
+    /** @brief Function stopFile() returns write end of wake pipe for signal handler.*/
+    static int& stopFile()
+    {
+        static int file = -1;
+        return file;
+    }
+
+    /** @brief Function stopSignal() is handler of SIGINT and SIGTERM, it wakes poll thread to stop.*/
+    static void stopSignal(int)
+    {
+        const char stop = 's';
+        if (stopFile() >= 0 && ::write(stopFile(), &stop, 1) < 0)
+            return;
+    }
+
+    /** @brief Function work() is loop of worker thread, it solves jobs until server stops.*/
+    void work()
+    {
+        for (;;)
+        {
+            std::unique_lock<std::mutex> guard(m_lock);
+            m_jobs_ready.wait(guard, [this]() { return m_stopping || !m_jobs.empty(); });
+            if (m_jobs.empty())
+                return;
+            Job job = std::move(m_jobs.front());
+            m_jobs.pop_front();
+            guard.unlock();
+
+            for (std::size_t i = 0; i < job.requests.size(); i++)
+            {
+                if (job.requests[i] == "stats")
+                {
+                    std::ostringstream out;
+                    stats().writeJson(out);
+                    job.answers += out.str();
+                }
+                else
+                {
+                    const std::size_t answers_size = job.answers.size();
+                    try
+                    {
+                        solveLine(job.requests[i], m_settings, job.answers);
+                    }
+                    catch (const std::exception &)      /**< out of memory fails only this request*/
+                    {
+                        job.answers.resize(answers_size);
+                        appendError(job.answers, "cannot solve group", m_settings.format);
+                    }
+                }
+
+                stats().addLatency(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                   std::chrono::steady_clock::now() - job.arrivals[i]).count());
+            }
+
+            guard.lock();
+            m_solved.push_back(std::move(job));
+            guard.unlock();
+
+            const char solved = 'j';
+            if (::write(m_wake[1], &solved, 1) < 0)
+                return;
+        }
+    }
+
+    /**
+     * @brief Function receive() reads available bytes of connection and splits them in requests.
+     *
+     * Empty lines and lines starting with '#' are skipped as in batch. At the end of input last line without new line
+     * is a request too. Line longer than server_max_request ends input of the connection, so received bytes cannot
+     * grow without end.
+     */
+    void receive(Connection &connection)
+    {
+        char buffer[65536];
+        const ssize_t count = ::read(connection.input, buffer, sizeof(buffer));
+        if (count < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR))
+            return;
+        if (count <= 0)
+            connection.end_of_input = true;
+        else
+            connection.received.append(buffer, count);
+
+        const time_point now = std::chrono::steady_clock::now();
+        std::size_t begin = 0;
+        for (;;)
+        {
+            std::size_t end = connection.received.find('\n', begin);
+            if (end == std::string::npos)
+            {
+                if (!connection.end_of_input || begin == connection.received.size())
+                    break;
+                end = connection.received.size();
+            }
+            if (end - begin > server_max_request)
+            {
+                begin = connection.received.size();
+                connection.overlong = true;
+                break;
+            }
+
+            std::string line = connection.received.substr(begin, end - begin);
+            begin = end < connection.received.size() ? end + 1 : end;
+
+            const std::size_t first = line.find_first_not_of(" \t\r");
+            if (first == std::string::npos || line[first] == '#')
+                continue;
+            line.erase(line.find_last_not_of(" \t\r") + 1);
+            connection.requests.push_back(line.substr(first));
+            connection.arrivals.push_back(now);
+        }
+        connection.received.erase(0, begin);
+
+        if (connection.received.size() > server_max_request)      /**< line without new line that is too long*/
+        {
+            connection.received.clear();
+            connection.overlong = true;
+        }
+        if (connection.overlong)
+            connection.end_of_input = true;
+    }
+
+    /** @brief Function send() writes as much of answers of connection as descriptor takes.*/
+    void send(Connection &connection)
+    {
+        const ssize_t count = connection.socket
+                            ? ::send(connection.output, connection.answers.data(), connection.answers.size(), MSG_NOSIGNAL)
+                            : ::write(connection.output, connection.answers.data(), connection.answers.size());
+        if (count < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR))
+            return;
+        if (count < 0)                                        /**< client is gone*/
+        {
+            connection.answers.clear();
+            connection.requests.clear();
+            connection.arrivals.clear();
+            connection.end_of_input = true;
+            return;
+        }
+        connection.answers.erase(0, count);
+    }
+
+    /**
+     * @brief Function run() polls connections until the last one ends (standard input) or until the server is stopped.
+     *
+     * Connection is not read while server_max_queued of its requests wait or server_max_answers bytes of its answers
+     * are not written, so pipelined requests and answers that client does not read cannot take all memory. Queued
+     * requests go to one job, so its answers are bounded too.
+     *
+     * @param listen_file listening socket, -1 when only standard input and output are served
+     */
+    void run(const int listen_file)
+    {
+        enum Kind { kind_wake, kind_listen, kind_input, kind_output };
+        std::vector<pollfd> files;
+        std::vector<std::pair<Kind, unsigned>> owners;
+        bool stop = false;
+
+        while (!stop)
+        {
+            files.clear();
+            owners.clear();
+            files.push_back(pollfd{m_wake[0], POLLIN, 0});
+            owners.emplace_back(kind_wake, 0);
+            if (listen_file >= 0)
+            {
+                files.push_back(pollfd{listen_file, POLLIN, 0});
+                owners.emplace_back(kind_listen, 0);
+            }
+            for (auto &it : m_connections)
+            {
+                if (!it.second.end_of_input && it.second.requests.size() < server_max_queued &&
+                    it.second.answers.size() < server_max_answers)     /**< client that does not read waits*/
+                {
+                    files.push_back(pollfd{it.second.input, POLLIN, 0});
+                    owners.emplace_back(kind_input, it.first);
+                }
+                if (!it.second.answers.empty())
+                {
+                    files.push_back(pollfd{it.second.output, POLLOUT, 0});
+                    owners.emplace_back(kind_output, it.first);
+                }
+            }
+
+            if (::poll(files.data(), files.size(), -1) < 0 && errno != EINTR)
+                break;
+
+            for (std::size_t i = 0; i < files.size(); i++)
+            {
+                if (files[i].revents == 0)
+                    continue;
+
+                if (owners[i].first == kind_wake)
+                {
+                    char signals[64];
+                    const ssize_t count = ::read(m_wake[0], signals, sizeof(signals));
+                    for (ssize_t c = 0; c < count; c++)
+                        if (signals[c] == 's')
+                            stop = true;
+
+                    std::lock_guard<std::mutex> guard(m_lock);
+                    for (auto &job : m_solved)
+                    {
+                        auto found = m_connections.find(job.connection);
+                        if (found == m_connections.end())
+                            continue;
+                        found->second.answers += job.answers;
+                        found->second.busy = false;
+                    }
+                    m_solved.clear();
+                }
+                else if (owners[i].first == kind_listen)
+                {
+                    for (int client; (client = ::accept(listen_file, nullptr, nullptr)) >= 0; )
+                    {
+                        ::fcntl(client, F_SETFL, ::fcntl(client, F_GETFL) | O_NONBLOCK);
+                        m_connections[m_next_connection++] = Connection{client, client, true, false, false, false, {}, {}, {}, {}};
+                    }
+                }
+                else if (owners[i].first == kind_input)
+                    receive(m_connections[owners[i].second]);
+                else
+                    send(m_connections[owners[i].second]);
+            }
+
+            for (auto it = m_connections.begin(); it != m_connections.end(); )
+            {
+                Connection &connection = it->second;
+                if (!connection.busy && !connection.requests.empty())    /**< all waiting requests in one job*/
+                {
+                    Job job{it->first, std::move(connection.requests), std::move(connection.arrivals), std::string()};
+                    connection.requests.clear();
+                    connection.arrivals.clear();
+                    connection.busy = true;
+
+                    std::lock_guard<std::mutex> guard(m_lock);
+                    m_jobs.push_back(std::move(job));
+                    m_jobs_ready.notify_one();
+                }
+
+                if (connection.overlong && !connection.busy && connection.requests.empty())   /**< after answers of earlier requests*/
+                {
+                    appendError(connection.answers, "request longer than " + std::to_string(server_max_request) + " bytes",
+                                m_settings.format);
+                    connection.overlong = false;
+                }
+
+                if (connection.end_of_input && !connection.busy && connection.requests.empty() && connection.answers.empty())
+                {
+                    if (connection.socket)
+                        ::close(connection.input);
+                    else
+                        stop = true;                              /**< standard input ended and all answers are written*/
+                    it = m_connections.erase(it);
+                }
+                else
+                    ++it;
+            }
+        }
+    }
+
+public:
+
+    /**
+     * @brief Constructor of a class starts worker threads.
+     *
+     * @param settings solver, capacity and cache used for all requests, must live as long as the server
+     * @param number_of_threads number of worker threads
+     */
+    solverServer(const SolverSettings &settings, unsigned number_of_threads)
+    : m_settings(settings), m_stopping(false), m_next_connection(0)
+    {
+        if (::pipe(m_wake) != 0)
+            m_wake[0] = m_wake[1] = -1;
+
+        if (number_of_threads == 0)
+            number_of_threads = 1;
+        for (unsigned t = 0; t < number_of_threads; t++)
+            m_workers.emplace_back([this]() { work(); });
+    }
+
+    /** @brief Destructor of a class stops worker threads and closes connections.*/
+    ~solverServer()
+    {
+        {
+            std::lock_guard<std::mutex> guard(m_lock);
+            m_stopping = true;
+        }
+        m_jobs_ready.notify_all();
+        for (auto &worker : m_workers)
+            worker.join();
+
+        for (auto &it : m_connections)
+            if (it.second.socket)
+                ::close(it.second.input);
+        stopFile() = -1;
+        ::close(m_wake[0]);
+        ::close(m_wake[1]);
+    }
+
+    solverServer(const solverServer&) = delete;
+    solverServer& operator= (const solverServer&) = delete;
+
+    /**
+     * @brief Function serveSocket() listens on Unix domain socket and answers clients until SIGINT or SIGTERM.
+     *
+     * @param path path of the socket, existing socket file is replaced
+     * @return false if socket cannot be made
+     */
+    bool serveSocket(const std::string &path)
+    {
+        sockaddr_un address;
+        std::memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        if (m_wake[0] < 0 || path.empty() || path.size() >= sizeof(address.sun_path))
+            return false;
+        std::memcpy(address.sun_path, path.c_str(), path.size());
+
+        const int listen_file = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (listen_file < 0)
+            return false;
+        ::unlink(path.c_str());
+        if (::bind(listen_file, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || ::listen(listen_file, 128) != 0)
+        {
+            ::close(listen_file);
+            return false;
+        }
+        ::fcntl(listen_file, F_SETFL, ::fcntl(listen_file, F_GETFL) | O_NONBLOCK);
+
+        stopFile() = m_wake[1];
+        ::signal(SIGINT, stopSignal);
+        ::signal(SIGTERM, stopSignal);
+        ::signal(SIGPIPE, SIG_IGN);
+
+        run(listen_file);
+
+        ::close(listen_file);
+        ::unlink(path.c_str());
+        return true;
+    }
+
+    /**
+     * @brief Function serveStream() answers requests from standard input on standard output until end of input.
+     *
+     * Answer is written as soon as it is solved, so client can keep pipe open and send next request after answer.
+     *
+     * @return false if server cannot be started
+     */
+    bool serveStream()
+    {
+        if (m_wake[0] < 0)
+            return false;
+
+        ::signal(SIGPIPE, SIG_IGN);
+        m_connections[m_next_connection++] = Connection{STDIN_FILENO, STDOUT_FILENO, false, false, false, false, {}, {}, {}, {}};
+        run(-1);
+        return true;
+    }
+};
+
+
+#endif // TUNNEL_H